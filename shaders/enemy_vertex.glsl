@@ -0,0 +1,43 @@
+#version 330 core
+
+// Instanced enemies: the body-and-eyes mesh plus one record per enemy. The
+// heading turn is applied here instead of a CPU model/normal matrix.
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNormal;
+layout (location = 4) in vec4 aInstance;       // world position (xyz), heading in radians (w)
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+void main()
+{
+    // Yaw about +Y, 0 = facing +Z (Enemies::getHeading)
+    float c = cos(aInstance.w);
+    float s = sin(aInstance.w);
+    mat3 turn = mat3(c, 0.0, -s,
+                     0.0, 1.0, 0.0,
+                     s, 0.0, c);
+
+    vec4 worldPos = vec4(aInstance.xyz + turn * aPos, 1.0);
+    vec4 viewPos  = view * worldPos;
+    gl_Position   = projection * viewPos;
+
+    FragPos    = worldPos.xyz;
+    FragColor  = aColor;
+    FragNormal = turn * aNormal;
+    TexCoord   = vec2(0.0);
+    TexLayer   = 0.0;
+    Material   = 0;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
@@ -0,0 +1,66 @@
+#version 330 core
+
+// Exit gateway: the unit cube instanced once per block of a static layout
+// (Renderer::buildExitZoneMesh). Glow pulses, the bobbing beacon and the
+// sparks orbiting it are all computed here from time.
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec3 aNormal;
+layout (location = 5) in vec3 iCentre;   // relative to exitPos; added to the animated position of moving blocks
+layout (location = 6) in vec3 iScale;
+layout (location = 7) in vec3 iColor;
+layout (location = 8) in vec4 iPulse;    // brightness = x + y * sin(z * time + w)
+layout (location = 9) in vec2 iMotion;   // motion kind, spark index
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+uniform vec3 exitPos;
+uniform float time;
+
+// Motion kinds (Renderer.cpp)
+const float MOTION_BEACON = 1.0;
+const float MOTION_SPARK  = 2.0;
+
+const float BEACON_HEIGHT = 1.5;
+const float SPARK_RADIUS  = 0.7;
+const float SPARK_COUNT   = 6.0;
+
+void main()
+{
+    vec3 centre = iCentre;
+    if (iMotion.x >= MOTION_BEACON) {
+        float beaconY = BEACON_HEIGHT + sin(time * 1.5) * 0.2;
+        if (iMotion.x < MOTION_SPARK) {
+            centre += vec3(0.0, beaconY, 0.0);
+        } else {
+            float spark = iMotion.y;
+            float angle = time * 2.5 + spark * (6.283 / SPARK_COUNT);
+            centre += vec3(SPARK_RADIUS * cos(angle),
+                           beaconY + sin(time * 3.0 + spark * 1.2) * 0.15,
+                           SPARK_RADIUS * sin(angle));
+        }
+    }
+
+    // Axis-aligned scaling leaves the cube's normals unchanged
+    vec3 worldPos = exitPos + centre + aPos * iScale;
+    vec4 viewPos  = view * vec4(worldPos, 1.0);
+    gl_Position   = projection * viewPos;
+
+    FragPos    = worldPos;
+    FragColor  = iColor * (iPulse.x + iPulse.y * sin(iPulse.z * time + iPulse.w));
+    FragNormal = aNormal;
+    TexCoord   = vec2(0.0);
+    TexLayer   = 0.0;
+    Material   = 0;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
@@ -5,26 +5,53 @@ in vec3 FragNormal;
 in vec3 FragPos;
 in vec2 TexCoord;
 in float Visibility;
+flat in int Material;
+flat in float TexLayer;
 
 out vec4 outColor;
 
-uniform vec3 lightDir;
-uniform vec3 fogColor;
-uniform sampler2D wallTexture;
-uniform bool useTexture;
+// Permutation defines (ShaderVariants.h), inserted after #version:
+//   USE_TEXTURE   sample materialTextures at TexLayer (if not negative)
+//   ALPHA_TEST    discard transparent texels (graffiti decals only, so every
+//                 opaque variant keeps early depth testing)
+//   TORCH_LIGHT   add the torch point light
+//   EDGE_OUTLINE  darken cell edges for the blocky look
 
-// Sun/sky lighting
-uniform vec3 sunColor;
-uniform float ambientLevel;
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
 
-// Torch lighting
-uniform bool torchEnabled;
-uniform vec3 torchPos;
-uniform vec3 torchColor;
-uniform float torchRadius;
+#ifdef USE_TEXTURE
+uniform sampler2DArray materialTextures;   // every material and decal, one layer each
+#endif
 
-// Edge outline effect
-uniform bool enableEdgeOutline;
+// Maze surface materials (see Renderer::buildChunkMesh)
+const int MAT_STONE = 1;
+const int MAT_GRASS = 2;
+const float CELL_SIZE = 2.0;
+
+uint cellHash(ivec2 cell, uint kx, uint ky)
+{
+    uint h = uint(cell.x) * kx + uint(cell.y) * ky;
+    h = ((h >> 16) ^ h) * 0x45d9f3bu;
+    return (h >> 16) ^ h;
+}
+
+// Per-cell colour variation, so merged faces still look cell by cell
+vec3 materialColor(vec3 norm)
+{
+    // Step back off the face into the cell it belongs to
+    ivec2 cell = ivec2(floor((FragPos.xz - norm.xz * 0.01) / CELL_SIZE));
+    if (Material == MAT_STONE) {
+        uint h = cellHash(cell, 7919u, 104729u);
+        float variation = float(h % 100u) / 500.0;
+        uint variant = h % 5u;
+        if (variant == 0u) return vec3(0.35, 0.42, 0.30) + variation;  // mossy stone brick
+        if (variant == 1u) return vec3(0.50, 0.48, 0.45) + variation;  // cobblestone
+        return vec3(0.45, 0.43, 0.40) + variation;                      // stone brick
+    }
+    uint h = cellHash(cell, 3571u, 7907u);
+    float fvar = float(h % 100u) / 600.0;
+    return vec3(0.28 + fvar * 0.5, 0.45 + fvar, 0.18 + fvar * 0.3);   // grass
+}
 
 void main()
 {
@@ -39,43 +66,51 @@ void main()
     vec3 tint = mix(vec3(0.7, 0.75, 0.9), sunColor, 0.6);
 
     vec3 baseColor = FragColor;
+    if (Material == MAT_STONE || Material == MAT_GRASS)
+        baseColor = materialColor(norm);
     float alpha = 1.0;
-    if (useTexture) {
-        vec4 texSample = texture(wallTexture, TexCoord);
-        baseColor = texSample.rgb * FragColor;
-        alpha = texSample.a;
-        if (alpha < 0.1) discard; // alpha test for graffiti transparency
-    }
+#ifdef USE_TEXTURE
+    // A negative layer marks untextured geometry in a textured draw (the
+    // viewmodel's hands)
+    vec4 texSample = texture(materialTextures, vec3(TexCoord, max(TexLayer, 0.0)));
+    if (TexLayer >= 0.0)
+        baseColor = texSample.rgb * baseColor;
+#ifdef ALPHA_TEST
+    alpha = texSample.a;
+    if (alpha < 0.1) discard; // alpha test for graffiti transparency
+#endif
+#endif
 
     vec3 color = baseColor * light * tint;
 
+#ifdef TORCH_LIGHT
     // Torch point light contribution
-    if (torchEnabled) {
-        vec3 toTorch = torchPos - FragPos;
-        float dist = length(toTorch);
-        if (dist < torchRadius) {
-            vec3 torchDir = normalize(toTorch);
-            float torchDiff = max(dot(norm, torchDir), 0.0);
-            // Radial falloff (quadratic attenuation)
-            const float LINEAR_ATTEN = 0.15;
-            const float QUADRATIC_ATTEN = 0.08;
-            float attenuation = 1.0 / (1.0 + LINEAR_ATTEN * dist + QUADRATIC_ATTEN * dist * dist);
-            float falloff = clamp(1.0 - dist / torchRadius, 0.0, 1.0);
-            falloff = falloff * falloff; // smooth falloff
-            vec3 torchContrib = torchColor * torchDiff * attenuation * falloff * 2.5;
-            color += baseColor * torchContrib;
-        }
+    vec3 toTorch = torchPos - FragPos;
+    float dist = length(toTorch);
+    if (dist < torchRadius) {
+        vec3 torchDir = normalize(toTorch);
+        float torchDiff = max(dot(norm, torchDir), 0.0);
+        // Radial falloff (quadratic attenuation)
+        const float LINEAR_ATTEN = 0.15;
+        const float QUADRATIC_ATTEN = 0.08;
+        float attenuation = 1.0 / (1.0 + LINEAR_ATTEN * dist + QUADRATIC_ATTEN * dist * dist);
+        float falloff = clamp(1.0 - dist / torchRadius, 0.0, 1.0);
+        falloff = falloff * falloff; // smooth falloff
+        vec3 torchContrib = torchColor * torchDiff * attenuation * falloff * 2.5;
+        color += baseColor * torchContrib;
     }
+#endif
 
-    // Edge outline effect for blocky aesthetic
-    if (enableEdgeOutline) {
-        // Detect edges using texture coordinate proximity to 0/1 boundaries
-        const float EDGE_WIDTH = 0.02;
-        float edgeX = min(TexCoord.x, 1.0 - TexCoord.x);
-        float edgeY = min(TexCoord.y, 1.0 - TexCoord.y);
-        float edgeFactor = smoothstep(0.0, EDGE_WIDTH, min(edgeX, edgeY));
-        color *= mix(0.6, 1.0, edgeFactor);
-    }
+#ifdef EDGE_OUTLINE
+    // Edge outline effect for blocky aesthetic: detect edges using texture coordinate proximity to 0/1 boundaries
+    // (fract: merged maze faces repeat the texture once per cell)
+    const float EDGE_WIDTH = 0.02;
+    vec2 tile = fract(TexCoord);
+    float edgeX = min(tile.x, 1.0 - tile.x);
+    float edgeY = min(tile.y, 1.0 - tile.y);
+    float edgeFactor = smoothstep(0.0, EDGE_WIDTH, min(edgeX, edgeY));
+    color *= mix(0.6, 1.0, edgeFactor);
+#endif
 
     // Mix with fog
     color = mix(fogColor, color, Visibility);
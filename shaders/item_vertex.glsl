@@ -0,0 +1,51 @@
+#version 330 core
+
+// Instanced gift boxes: the unit-cube mesh plus one record per box. Spin
+// and bob are computed here from a shared angle instead of a CPU matrix.
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec2 aTexCoord;
+layout (location = 4) in vec4 aInstance;       // world position (xyz), spin phase in degrees (w)
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+uniform float spinAngle;   // degrees, shared by every spinning box
+uniform float itemSize;
+
+const float LAYER_GIFT_BOX = 2.0;   // Renderer.cpp texture array layout
+
+void main()
+{
+    float angle = spinAngle + aInstance.w;
+    float bob   = sin(angle * 0.03) * 0.15;
+
+    float c = cos(radians(angle));
+    float s = sin(radians(angle));
+    mat3 spin = mat3(c, 0.0, -s,
+                     0.0, 1.0, 0.0,
+                     s, 0.0, c);
+
+    vec4 worldPos = vec4(aInstance.xyz + vec3(0.0, bob, 0.0) + spin * (aPos * itemSize), 1.0);
+    vec4 viewPos  = view * worldPos;
+    gl_Position   = projection * viewPos;
+
+    FragPos    = worldPos.xyz;
+    FragColor  = aColor;
+    FragNormal = spin * aNormal;
+    TexCoord   = aTexCoord;
+    TexLayer   = LAYER_GIFT_BOX;
+    Material   = 0;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
@@ -0,0 +1,133 @@
+#version 330 core
+
+// Vertex pulling straight from the maze grid: one instance per cell, six
+// vertices per face, no vertex buffers. Faces that don't exist (or lie
+// beyond the fog) collapse to a degenerate point.
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+uniform usampler2D mazeGrid;   // CellType per texel
+uniform ivec2 gridSize;
+uniform float cullDistance;
+
+const float CELL_SIZE   = 2.0;
+const float WALL_HEIGHT = 4.0;
+
+// Texture array layers (Renderer.cpp)
+const float LAYER_WALL   = 0.0;
+const float LAYER_GROUND = 1.0;
+
+// CellType values (Maze.h)
+const uint CELL_WALL = 0u;
+const uint CELL_PATH = 1u;
+const uint CELL_DOOR = 2u;
+const uint CELL_GATE = 3u;
+
+// Material ids (Renderer.cpp)
+const int MAT_CEILING = 0;
+const int MAT_STONE   = 1;
+const int MAT_GRASS   = 2;
+const int MAT_DOOR    = 3;
+const int MAT_GATE    = 4;
+
+// Faces: floor, ceiling, +X, -X, +Z, -Z. Corners are offsets (x, z, level)
+// from the cell's grid corner, counter-clockwise from texcoord (0,0).
+const ivec3 CORNERS[24] = ivec3[24](
+    ivec3(0,0,0), ivec3(1,0,0), ivec3(1,1,0), ivec3(0,1,0),   // floor
+    ivec3(0,1,1), ivec3(1,1,1), ivec3(1,0,1), ivec3(0,0,1),   // ceiling
+    ivec3(1,1,0), ivec3(1,0,0), ivec3(1,0,1), ivec3(1,1,1),   // +X
+    ivec3(0,0,0), ivec3(0,1,0), ivec3(0,1,1), ivec3(0,0,1),   // -X
+    ivec3(0,1,0), ivec3(1,1,0), ivec3(1,1,1), ivec3(0,1,1),   // +Z
+    ivec3(1,0,0), ivec3(0,0,0), ivec3(0,0,1), ivec3(1,0,1));  // -Z
+const int QUAD_ORDER[6] = int[6](0, 1, 2, 2, 3, 0);
+
+// Normal index per face, as in maze_vertex.glsl (+X, -X, +Y, -Y, +Z, -Z)
+const int FACE_NORMAL[6] = int[6](2, 3, 0, 1, 4, 5);
+const ivec2 FACE_NEIGHBOUR[6] = ivec2[6](
+    ivec2(0, 0), ivec2(0, 0), ivec2(1, 0), ivec2(-1, 0), ivec2(0, 1), ivec2(0, -1));
+
+const vec3 NORMALS[6] = vec3[6](
+    vec3( 1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3( 0.0, 1.0, 0.0), vec3( 0.0,-1.0, 0.0),
+    vec3( 0.0, 0.0, 1.0), vec3( 0.0, 0.0,-1.0));
+
+const vec3 COLORS[5] = vec3[5](
+    vec3(0.12, 0.12, 0.15),   // ceiling: dark stone
+    vec3(1.0),                // stone brick (tinted per cell in fragment.glsl)
+    vec3(1.0),                // grass (tinted per cell in fragment.glsl)
+    vec3(0.42, 0.26, 0.12),   // locked door: dark oak planks
+    vec3(0.28, 0.30, 0.36));  // closed gate: cold iron
+
+uint cellAt(ivec2 cell)
+{
+    if (any(lessThan(cell, ivec2(0))) || any(greaterThanEqual(cell, gridSize)))
+        return CELL_WALL;
+    return texelFetch(mazeGrid, cell, 0).r;
+}
+
+void main()
+{
+    ivec2 cell = ivec2(gl_InstanceID % gridSize.x, gl_InstanceID / gridSize.x);
+    int face = gl_VertexID / 6;
+    uint type = cellAt(cell);
+
+    bool exists;
+    int material;
+    if (face < 2) {
+        exists = (type == CELL_PATH);
+        material = (face == 0) ? MAT_GRASS : MAT_CEILING;
+    } else {
+        exists = (type != CELL_PATH) && (cellAt(cell + FACE_NEIGHBOUR[face]) == CELL_PATH);
+        material = (type == CELL_DOOR) ? MAT_DOOR : (type == CELL_GATE) ? MAT_GATE : MAT_STONE;
+    }
+
+    vec2 centre = (vec2(cell) + 0.5) * CELL_SIZE;
+    if (!exists || distance(centre, cameraPos.xz) > cullDistance + CELL_SIZE) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);   // degenerate, and outside the clip volume
+        FragColor = vec3(0.0);
+        FragNormal = vec3(0.0, 1.0, 0.0);
+        FragPos = vec3(0.0);
+        TexCoord = vec2(0.0);
+        Visibility = 0.0;
+        Material = 0;
+        TexLayer = 0.0;
+        return;
+    }
+
+    ivec3 corner = CORNERS[face * 4 + QUAD_ORDER[gl_VertexID % 6]];
+    vec2 grid = vec2(cell + corner.xy);
+    float level = float(corner.z);
+    int normalIndex = FACE_NORMAL[face];
+
+    vec3 worldPos = vec3(grid.x * CELL_SIZE, level * WALL_HEIGHT, grid.y * CELL_SIZE);
+    vec4 viewPos  = view * vec4(worldPos, 1.0);
+    gl_Position   = projection * viewPos;
+
+    // One texture repeat per cell, oriented like the mesh path
+    vec2 uv;
+    if      (normalIndex == 0) uv = vec2(-grid.y, level);   // +X
+    else if (normalIndex == 1) uv = vec2( grid.y, level);   // -X
+    else if (normalIndex == 2) uv = vec2( grid.x, grid.y);  // floor
+    else if (normalIndex == 3) uv = vec2( grid.x,-grid.y);  // ceiling
+    else if (normalIndex == 4) uv = vec2( grid.x, level);   // +Z
+    else                       uv = vec2(-grid.x, level);   // -Z
+
+    FragPos    = worldPos;
+    FragColor  = COLORS[material];
+    FragNormal = NORMALS[normalIndex];
+    TexCoord   = uv;
+    Material   = material;
+    TexLayer   = (material == MAT_GRASS) ? LAYER_GROUND : LAYER_WALL;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
@@ -0,0 +1,69 @@
+#version 330 core
+
+// Packed maze vertex (see MazeVertex in Renderer.cpp)
+layout (location = 0) in uvec2 aGrid;   // cell corner (x, z)
+layout (location = 1) in uvec3 aInfo;   // level (0 floor, 1 ceiling), normal index, material id
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+const float CELL_SIZE   = 2.0;
+const float WALL_HEIGHT = 4.0;
+
+// Texture array layers (Renderer.cpp)
+const float LAYER_WALL   = 0.0;
+const float LAYER_GROUND = 1.0;
+const int MAT_GRASS = 2;
+
+// Indexed by MAZE_NORMAL_*: +X, -X, +Y, -Y, +Z, -Z
+const vec3 NORMALS[6] = vec3[6](
+    vec3( 1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0),
+    vec3( 0.0, 1.0, 0.0), vec3( 0.0,-1.0, 0.0),
+    vec3( 0.0, 0.0, 1.0), vec3( 0.0, 0.0,-1.0));
+
+// Indexed by MAT_*: ceiling, stone, grass, door, gate. Stone and grass are
+// tinted per cell in the fragment shader.
+const vec3 COLORS[5] = vec3[5](
+    vec3(0.12, 0.12, 0.15),   // ceiling: dark stone
+    vec3(1.0),                // stone brick
+    vec3(1.0),                // grass
+    vec3(0.42, 0.26, 0.12),   // locked door: dark oak planks
+    vec3(0.28, 0.30, 0.36));  // closed gate: cold iron
+
+void main()
+{
+    vec2 grid = vec2(aGrid);
+    float level = float(aInfo.x);
+    int normalIndex = int(aInfo.y);
+
+    vec3 worldPos = vec3(grid.x * CELL_SIZE, level * WALL_HEIGHT, grid.y * CELL_SIZE);
+    vec4 viewPos  = view * vec4(worldPos, 1.0);
+    gl_Position   = projection * viewPos;
+
+    // One texture repeat per cell, oriented like the original cube faces
+    vec2 uv;
+    if      (normalIndex == 0) uv = vec2(-grid.y, level);   // +X
+    else if (normalIndex == 1) uv = vec2( grid.y, level);   // -X
+    else if (normalIndex == 2) uv = vec2( grid.x, grid.y);  // floor
+    else if (normalIndex == 3) uv = vec2( grid.x,-grid.y);  // ceiling
+    else if (normalIndex == 4) uv = vec2( grid.x, level);   // +Z
+    else                       uv = vec2(-grid.x, level);   // -Z
+
+    FragPos    = worldPos;
+    FragColor  = COLORS[int(aInfo.z)];
+    FragNormal = NORMALS[normalIndex];
+    TexCoord   = uv;
+    Material   = int(aInfo.z);
+    TexLayer   = (Material == MAT_GRASS) ? LAYER_GROUND : LAYER_WALL;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
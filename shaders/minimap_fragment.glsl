@@ -0,0 +1,83 @@
+#version 330 core
+
+out vec4 outColor;
+
+uniform sampler2D mazeMap;       // one texel per cell: 1 = open (MinimapRenderer.h)
+uniform sampler2D exploredMap;   // one texel per cell: 1 = explored
+uniform ivec2 mazeSize;
+uniform vec2 panelCentre;        // pixels
+uniform float panelRadius;       // circle radius, or half the overview square
+uniform float cellPixels;        // on-screen size of one cell
+uniform vec2 playerCell;         // continuous cell coordinates (world xz / CELL_SIZE)
+uniform vec2 exitCell;
+uniform vec2 playerDir;          // facing in screen space, y up
+uniform bool overview;           // whole maze, filtered, instead of the corner map
+
+const vec3 BACKGROUND = vec3(0.05, 0.05, 0.08);
+const vec3 WALL       = vec3(0.25);
+const vec3 PATH       = vec3(0.55, 0.55, 0.65);
+const vec3 EXIT       = vec3(0.9, 0.6, 0.1);
+const vec3 ARROW      = vec3(0.2, 0.9, 0.7);
+
+const float ARROW_LENGTH = 12.0;
+const float ARROW_WIDTH  = 6.0;
+
+float edgeSide(vec2 p, vec2 a, vec2 b)
+{
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+void main()
+{
+    vec2 px = gl_FragCoord.xy - panelCentre;
+    if (overview) {
+        if (max(abs(px.x), abs(px.y)) > panelRadius) discard;
+    } else if (length(px) > panelRadius) {
+        discard;
+    }
+
+    // Maze rows run down the screen; the corner map scrolls with the player
+    vec2 focus = overview ? vec2(mazeSize) * 0.5 : playerCell;
+    vec2 cellPos = focus + vec2(px.x, -px.y) / cellPixels;
+    bool inside = all(greaterThanEqual(cellPos, vec2(0.0))) &&
+                  all(lessThan(cellPos, vec2(mazeSize)));
+
+    float open, seen;
+    if (overview) {
+        // Trilinear through the mips: many cells per pixel average out
+        // instead of aliasing (sampled outside the non-uniform branch below)
+        vec2 uv = cellPos / vec2(mazeSize);
+        open = texture(mazeMap, uv).r;
+        seen = texture(exploredMap, uv).r;
+    } else {
+        ivec2 cell = clamp(ivec2(floor(cellPos)), ivec2(0), mazeSize - 1);
+        open = texelFetch(mazeMap, cell, 0).r;
+        seen = texelFetch(exploredMap, cell, 0).r;
+        // Gap between cells for the tiled look
+        vec2 f = abs(fract(cellPos) - 0.5);
+        if (max(f.x, f.y) > 0.45) seen = 0.0;
+    }
+
+    vec3 color = BACKGROUND;
+    if (inside)
+        color = mix(BACKGROUND, mix(WALL, PATH, open), seen);
+
+    // Exit marker, always shown
+    vec2 toExit = abs(cellPos - exitCell) * cellPixels;
+    if (max(toExit.x, toExit.y) <= max(cellPixels * 0.35, 3.0))
+        color = EXIT;
+
+    // Player arrow: inside the triangle when on the same side of all edges
+    vec2 p = px - (playerCell - focus) * vec2(1.0, -1.0) * cellPixels;
+    vec2 perp = vec2(-playerDir.y, playerDir.x);
+    vec2 tip   = playerDir * ARROW_LENGTH;
+    vec2 left  = -playerDir * (ARROW_LENGTH * 0.4) + perp * ARROW_WIDTH;
+    vec2 right = -playerDir * (ARROW_LENGTH * 0.4) - perp * ARROW_WIDTH;
+    float e0 = edgeSide(p, tip, left);
+    float e1 = edgeSide(p, left, right);
+    float e2 = edgeSide(p, right, tip);
+    if ((e0 >= 0.0 && e1 >= 0.0 && e2 >= 0.0) || (e0 <= 0.0 && e1 <= 0.0 && e2 <= 0.0))
+        color = ARROW;
+
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,12 @@
+#version 330 core
+
+// One quad covering the minimap panel, built from gl_VertexID (no buffers)
+uniform vec4 panelRect;    // NDC x0, y0, x1, y1
+
+const vec2 CORNERS[6] = vec2[6](vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+                                vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main()
+{
+    gl_Position = vec4(mix(panelRect.xy, panelRect.zw, CORNERS[gl_VertexID]), 0.0, 1.0);
+}
@@ -0,0 +1,34 @@
+#version 330 core
+
+layout (location = 0) in vec2 aCorner;     // unit quad corner, -1..1
+// Per-instance, one ParticleSystem array each
+layout (location = 1) in float aPosX;
+layout (location = 2) in float aPosY;
+layout (location = 3) in float aPosZ;
+layout (location = 4) in float aSize;      // half extent: NDC or world units
+layout (location = 5) in float aLife;
+layout (location = 6) in float aMaxLife;
+layout (location = 7) in vec4 aColor;
+
+out vec3 vColor;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+uniform bool screenSpace;   // positions are NDC, no camera
+
+void main()
+{
+    // Shrink and darken (blending is additive) as the particle ages
+    float fade = clamp(aLife / aMaxLife, 0.0, 1.0);
+    vec2 offset = aCorner * aSize * fade;
+
+    if (screenSpace) {
+        gl_Position = vec4(vec2(aPosX, aPosY) + offset, 0.0, 1.0);
+    } else {
+        // Billboard: spread the corners in view space so it faces the camera
+        vec4 viewPos = view * vec4(aPosX, aPosY, aPosZ, 1.0);
+        viewPos.xy += offset;
+        gl_Position = projection * viewPos;
+    }
+    vColor = aColor.rgb * fade;
+}
@@ -0,0 +1,32 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec3 aColor;
+layout (location = 2) in float aAnim;   // TitleScreen::Anim
+
+out vec3 vColor;
+
+uniform float time;
+
+// The title screen's geometry is cached; everything that moves or pulses is
+// animated here so idle frames upload nothing
+void main()
+{
+    vec2 pos = aPos;
+    vec3 color = aColor;
+    int anim = int(aAnim + 0.5);
+
+    if (anim == 1) {
+        pos.y += sin(time * 1.5) * 0.015;                 // title bob
+    } else if (anim == 2 || anim == 3) {
+        pos.y += sin(time * 4.0) * 0.005;                 // selected menu item
+        if (anim == 3) color *= 0.7 + 0.3 * sin(time * 3.5);
+    } else if (anim == 4) {
+        color *= 0.1 + 0.08 * sin(time * 3.5);            // glow behind it
+    } else if (anim == 5) {
+        pos.y += sin(time * 3.0) * 0.005;                 // difficulty name
+    }
+
+    gl_Position = vec4(pos, 0.0, 1.0);
+    vColor = color;
+}
@@ -4,29 +4,43 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 layout (location = 2) in vec3 aNormal;
 layout (location = 3) in vec2 aTexCoord;
+layout (location = 4) in float aLayer;     // texture array layer (decals), 0 otherwise
 
 out vec3 FragColor;
 out vec3 FragNormal;
 out vec3 FragPos;
 out vec2 TexCoord;
 out float Visibility;
+flat out int Material;
+flat out float TexLayer;
 
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+#ifndef STATIC_GEOMETRY
+// Per-object transform; normalMatrix is its inverse transpose, from the CPU
+// (Shader::setModel)
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform float fogDensity;
-uniform float fogGradient;
+uniform mat3 normalMatrix;
+#endif
 
 void main()
 {
+#ifdef STATIC_GEOMETRY
+    // Built in world space (decals), so nothing to transform
+    vec4 worldPos = vec4(aPos, 1.0);
+    FragNormal    = aNormal;
+#else
     vec4 worldPos = model * vec4(aPos, 1.0);
+    FragNormal    = normalMatrix * aNormal;
+#endif
     vec4 viewPos  = view * worldPos;
     gl_Position   = projection * viewPos;
 
     FragPos    = worldPos.xyz;
     FragColor  = aColor;
-    FragNormal = mat3(transpose(inverse(model))) * aNormal;
     TexCoord   = aTexCoord;
+    TexLayer   = aLayer;
+    Material   = 0;   // per-cell maze materials come from maze_vertex.glsl
 
     // Fog calculation
     float dist = length(viewPos.xyz);
@@ -0,0 +1,46 @@
+#version 330 core
+
+// First-person viewmodel (HandRenderer.h): hand cuboids and the carried box
+// stack as instances of one unit cube. Hands carry a view-space model matrix
+// (the hand camera's view is identity); boxes a world one, drawn with the
+// world view so lighting, fog and the torch see world positions.
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;     // flat per-face shading
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec2 aTexCoord;
+layout (location = 4) in mat4 aModel;     // locations 4-7
+layout (location = 8) in vec4 aTint;      // rgb colour, a = 1 for gift box texture
+
+out vec3 FragColor;
+out vec3 FragNormal;
+out vec3 FragPos;
+out vec2 TexCoord;
+out float Visibility;
+flat out int Material;
+flat out float TexLayer;
+
+// FrameCamera / FrameLighting are inserted after #version (FrameUniforms::GLSL_BLOCKS)
+
+const float LAYER_GIFT_BOX = 2.0;   // Renderer.cpp texture array layout
+
+void main()
+{
+    vec4 worldPos = aModel * vec4(aPos, 1.0);
+    vec4 viewPos  = view * worldPos;
+    gl_Position   = projection * viewPos;
+
+    // Boxes keep their texture's own shading; hands are flat-shaded per face
+    bool textured = aTint.a > 0.5;
+
+    FragPos    = worldPos.xyz;
+    FragColor  = textured ? aTint.rgb : aTint.rgb * aColor;
+    // Rotation and per-axis scale of a box: face normals stay face normals
+    FragNormal = mat3(aModel) * aNormal;
+    TexCoord   = aTexCoord;
+    TexLayer   = textured ? LAYER_GIFT_BOX : -1.0;
+    Material   = 0;
+
+    // Fog calculation
+    float dist = length(viewPos.xyz);
+    Visibility = clamp(exp(-pow(dist * fogDensity, fogGradient)), 0.0, 1.0);
+}
@@ -0,0 +1,331 @@
+#include "BotEnv.h"
+#include "Maze.h"
+#include "Player.h"
+#include "Collectible.h"
+#include "DistanceField.h"
+#include "DynamicWalls.h"
+#include "StarRating.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const float CELL_SIZE = 2.0f;
+static const float FIXED_DT  = 1.0f / 60.0f;
+static const float EXIT_ZONE_RADIUS = 3.0f;   // matches the exit platform in main.cpp
+
+// Reward shaping (per step)
+static const float REWARD_PICKUP  = 1.0f;
+static const float REWARD_DELIVER = 1.0f;   // per box delivered at the exit
+static const float REWARD_ESCAPE  = 10.0f;
+static const float REWARD_STEP    = -0.001f;
+
+// ── Worker pool ────────────────────────────────────────────────────────────
+// Persistent threads that split an index range into contiguous slices.
+// The calling thread works on slice 0, so N threads means N-1 workers.
+class WorkerPool {
+public:
+    explicit WorkerPool(int numThreads) {
+        for (int i = 1; i < numThreads; i++)
+            threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        startCv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    int sliceCount() const { return (int)threads.size() + 1; }
+
+    // Run fn(begin, end) over [0, count); blocks until every slice is done
+    void parallelFor(int count, const std::function<void(int, int)>& fn) {
+        if (threads.empty() || count <= 1) {
+            fn(0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            jobCount = count;
+            pending = (int)threads.size();
+            generation++;
+        }
+        startCv.notify_all();
+
+        runSlice(0, count, fn);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCv.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startCv, doneCv;
+    const std::function<void(int, int)>* job = nullptr;
+    int jobCount = 0;
+    int pending = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+
+    void runSlice(int slice, int count, const std::function<void(int, int)>& fn) {
+        int n = sliceCount();
+        int begin = (int)((long long)count * slice / n);
+        int end   = (int)((long long)count * (slice + 1) / n);
+        if (begin < end) fn(begin, end);
+    }
+
+    void workerLoop(int slice) {
+        unsigned long long seen = 0;
+        for (;;) {
+            const std::function<void(int, int)>* fn;
+            int count;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                startCv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                fn = job;
+                count = jobCount;
+            }
+            runSlice(slice, count, *fn);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pending == 0) doneCv.notify_one();
+            }
+        }
+    }
+};
+
+// ── Single environment ─────────────────────────────────────────────────────
+struct BotEnvironment {
+    Maze maze;
+    Player player;
+    Collectible collectibles;
+    DynamicWalls dynamicWalls;
+    DistanceField exitField;         // cell distance to the exit, repaired on wall changes
+    glm::vec3 exitWorldPos;
+    int steps;
+    unsigned int episode;
+
+    BotEnvironment() : maze(15, 15, 1), exitWorldPos(0.0f), steps(0), episode(0) {}
+};
+
+struct MazeEnvBatch {
+    std::vector<BotEnvironment> envs;
+    Difficulty difficulty;
+    unsigned int baseSeed;
+    int maxSteps;
+    WorkerPool pool;
+
+    // Throughput accounting (updated by the stepping thread only)
+    unsigned long long totalSteps;
+    double totalSeconds;
+
+    MazeEnvBatch(int numEnvs, Difficulty diff, unsigned int seed, int numThreads)
+        : envs(numEnvs), difficulty(diff), baseSeed(seed), maxSteps(60 * 300)
+        , pool(numThreads), totalSteps(0), totalSeconds(0.0)
+    {
+    }
+};
+
+// Distinct, non-zero seed per (environment, episode)
+static unsigned int episodeSeed(unsigned int base, int envIndex, unsigned int episode) {
+    unsigned int h = base ^ (unsigned int)(envIndex * 73856093) ^ (episode * 19349663u);
+    h = ((h >> 16) ^ h) * 0x45d9f3b;
+    h = (h >> 16) ^ h;
+    return h ? h : 1u;
+}
+
+static void resetEnvironment(BotEnvironment& env, Difficulty diff,
+                             unsigned int baseSeed, int envIndex) {
+    auto cfg = getDifficultyConfig(diff);
+
+    env.maze = Maze(cfg.mazeWidth, cfg.mazeHeight,
+                    episodeSeed(baseSeed, envIndex, env.episode));
+    env.maze.generate();
+    env.dynamicWalls.generate(env.maze);
+
+    auto [sx, sy] = env.maze.getStart();
+    env.player.init((float)sx, (float)sy);
+
+    auto [ex, ey] = env.maze.getExit();
+    env.exitWorldPos = glm::vec3(ex * CELL_SIZE + CELL_SIZE * 0.5f,
+                                 1.0f,
+                                 ey * CELL_SIZE + CELL_SIZE * 0.5f);
+
+    env.collectibles.placeItems(env.maze.getItemPositions(cfg.numItems));
+    env.exitField.build(env.maze, ex, ey);
+
+    env.steps = 0;
+    env.episode++;
+}
+
+static void writeObservation(const BotEnvironment& env, float* out) {
+    const int R = MAZE_ENV_VIEW_RADIUS;
+    const int W = MAZE_ENV_WINDOW;
+
+    int pcx = (int)std::floor(env.player.position.x / CELL_SIZE);
+    int pcy = (int)std::floor(env.player.position.z / CELL_SIZE);
+    auto [ex, ey] = env.maze.getExit();
+
+    for (int dy = -R; dy <= R; dy++) {
+        for (int dx = -R; dx <= R; dx++) {
+            int cx = pcx + dx, cy = pcy + dy;
+            float code = env.maze.isWall(cx, cy) ? 0.0f : 1.0f;
+            if (cx == ex && cy == ey) code = 3.0f;
+            out[(dy + R) * W + (dx + R)] = code;
+        }
+    }
+
+    // Stamp items still lying in the world (per-cell bucket lookup)
+    for (int dy = -R; dy <= R; dy++)
+        for (int dx = -R; dx <= R; dx++)
+            if (env.collectibles.hasItemInCell(pcx + dx, pcy + dy))
+                out[(dy + R) * W + (dx + R)] = 2.0f;
+
+    float yaw = std::fmod(env.player.yaw, 360.0f);
+    if (yaw < 0.0f) yaw += 360.0f;
+
+    int dist = env.exitField.get(pcx, pcy);
+
+    float* extra = out + W * W;
+    extra[0] = env.player.position.x;
+    extra[1] = env.player.position.z;
+    extra[2] = yaw;
+    extra[3] = (float)env.player.carriedItems.size();
+    extra[4] = (float)dist;
+}
+
+// Advance one environment by a fixed step; returns reward, sets done
+static float stepEnvironment(BotEnvironment& env, const MazeEnvAction& action,
+                             int maxSteps, bool& done) {
+    float reward = REWARD_STEP;
+    done = false;
+
+    env.player.yaw += action.turnDegrees;
+    env.player.update(FIXED_DT, env.maze,
+                      action.forward > 0, action.forward < 0,
+                      action.strafe < 0, action.strafe > 0,
+                      action.jump != 0);
+    env.collectibles.update(FIXED_DT);
+    env.steps++;
+
+    bool carryingKey = false;
+    for (int idx : env.player.carriedItems)
+        if (env.collectibles.getType(idx) == ItemType::KEY) carryingKey = true;
+    env.dynamicWalls.update(FIXED_DT, env.maze, env.player.position, carryingKey);
+    if (!env.dynamicWalls.getChangedCells().empty()) {
+        env.exitField.update(env.maze, env.dynamicWalls.getChangedCells());
+        env.dynamicWalls.clearChanges();
+    }
+
+    int idx = env.collectibles.tryPickup(env.player.position, false);
+    if (idx >= 0) {
+        env.player.carriedItems.push_back(idx);
+        reward += REWARD_PICKUP;
+    }
+
+    float distToExit = glm::length(env.player.position - env.exitWorldPos);
+    if (distToExit < EXIT_ZONE_RADIUS) {
+        for (int carried : env.player.carriedItems) {
+            env.collectibles.deposit(carried);
+            reward += REWARD_DELIVER;
+        }
+        env.player.carriedItems.clear();
+        reward += REWARD_ESCAPE;
+        done = true;
+    }
+
+    if (env.steps >= maxSteps) done = true;
+    return reward;
+}
+
+// ── C API ──────────────────────────────────────────────────────────────────
+extern "C" {
+
+MazeEnvBatch* maze_env_create(int numEnvs, int difficulty,
+                              unsigned int seed, int numThreads) {
+    if (numEnvs <= 0) return nullptr;
+    if (difficulty < 0 || difficulty > 3) difficulty = (int)Difficulty::MEDIUM;
+    if (seed == 0)
+        seed = static_cast<unsigned int>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+    if (numThreads <= 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, numEnvs);
+
+    return new MazeEnvBatch(numEnvs, (Difficulty)difficulty, seed, numThreads);
+}
+
+void maze_env_destroy(MazeEnvBatch* batch) {
+    delete batch;
+}
+
+int maze_env_count(const MazeEnvBatch* batch) {
+    return batch ? (int)batch->envs.size() : 0;
+}
+
+int maze_env_obs_size(void) {
+    return MAZE_ENV_WINDOW * MAZE_ENV_WINDOW + MAZE_ENV_OBS_EXTRA;
+}
+
+void maze_env_set_max_steps(MazeEnvBatch* batch, int maxSteps) {
+    if (batch && maxSteps > 0) batch->maxSteps = maxSteps;
+}
+
+void maze_env_reset(MazeEnvBatch* batch, float* obs) {
+    if (!batch) return;
+    const int obsSize = maze_env_obs_size();
+    batch->pool.parallelFor((int)batch->envs.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            resetEnvironment(batch->envs[i], batch->difficulty, batch->baseSeed, i);
+            if (obs) writeObservation(batch->envs[i], obs + (size_t)i * obsSize);
+        }
+    });
+}
+
+void maze_env_step(MazeEnvBatch* batch, const MazeEnvAction* actions,
+                   float* obs, float* rewards, uint8_t* dones) {
+    if (!batch || !actions) return;
+    const int obsSize = maze_env_obs_size();
+    auto start = std::chrono::steady_clock::now();
+
+    batch->pool.parallelFor((int)batch->envs.size(), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            BotEnvironment& env = batch->envs[i];
+            bool done = false;
+            float reward = stepEnvironment(env, actions[i], batch->maxSteps, done);
+            if (done)
+                resetEnvironment(env, batch->difficulty, batch->baseSeed, i);
+
+            if (rewards) rewards[i] = reward;
+            if (dones) dones[i] = done ? 1 : 0;
+            if (obs) writeObservation(env, obs + (size_t)i * obsSize);
+        }
+    });
+
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    batch->totalSteps += batch->envs.size();
+    batch->totalSeconds += seconds;
+}
+
+double maze_env_steps_per_second(const MazeEnvBatch* batch) {
+    if (!batch) return 0.0;
+    if (batch->totalSeconds <= 0.0) return 0.0;
+    return (double)batch->totalSteps / batch->totalSeconds;
+}
+
+} // extern "C"
@@ -0,0 +1,70 @@
+#ifndef BOTENV_H
+#define BOTENV_H
+
+#include <stdint.h>
+
+// ── Vectorised headless environment API for bots / RL agents ──────────────
+// Steps N independent mazes in lock-step. Each environment owns its own
+// Maze, Player and Collectible set; no OpenGL context is required.
+//
+// Observations are written straight into one caller-provided float buffer
+// laid out as numEnvs consecutive records of maze_env_obs_size() floats:
+//
+//   [0 .. W*W)   local grid window centred on the player's cell, row-major
+//                (W = 2 * MAZE_ENV_VIEW_RADIUS + 1). Cell codes:
+//                0 = wall (incl. closed doors/gates), 1 = open, 2 = item on the floor, 3 = exit
+//   W*W + 0      player x (world units)
+//   W*W + 1      player z (world units)
+//   W*W + 2      player yaw (degrees, wrapped to [0,360))
+//   W*W + 3      carried item count
+//   W*W + 4      grid distance to the exit in cells (-1 if unreachable)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAZE_ENV_VIEW_RADIUS 5
+#define MAZE_ENV_WINDOW      (2 * MAZE_ENV_VIEW_RADIUS + 1)
+#define MAZE_ENV_OBS_EXTRA   5
+
+// Fixed-size (8 byte) action slot, one per environment
+typedef struct MazeEnvAction {
+    int8_t  forward;      // -1 = back, 0 = none, 1 = forward
+    int8_t  strafe;       // -1 = left, 0 = none, 1 = right
+    uint8_t jump;         // non-zero to jump
+    uint8_t reserved;
+    float   turnDegrees;  // yaw change applied before moving
+} MazeEnvAction;
+
+typedef struct MazeEnvBatch MazeEnvBatch;
+
+// difficulty: 0=EASY .. 3=NIGHTMARE. seed 0 picks a time-based seed.
+// numThreads <= 0 uses std::thread::hardware_concurrency().
+MazeEnvBatch* maze_env_create(int numEnvs, int difficulty,
+                              unsigned int seed, int numThreads);
+void maze_env_destroy(MazeEnvBatch* batch);
+
+int maze_env_count(const MazeEnvBatch* batch);
+int maze_env_obs_size(void);
+
+// Episode length cap in fixed 60 Hz steps (default 60 * 300)
+void maze_env_set_max_steps(MazeEnvBatch* batch, int maxSteps);
+
+// Regenerate every environment and write initial observations to obs
+void maze_env_reset(MazeEnvBatch* batch, float* obs);
+
+// Advance every environment by one fixed step. actions holds one slot per
+// environment; obs/rewards/dones receive numEnvs records each. Finished
+// environments are reset automatically and report the new episode's
+// first observation with dones[i] = 1.
+void maze_env_step(MazeEnvBatch* batch, const MazeEnvAction* actions,
+                   float* obs, float* rewards, uint8_t* dones);
+
+// Environment steps per second measured across all maze_env_step calls
+double maze_env_steps_per_second(const MazeEnvBatch* batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
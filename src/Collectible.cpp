@@ -1,47 +1,132 @@
 #include "Collectible.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <climits>
 #include <cmath>
 
 static const float CELL_SIZE = 2.0f;
 
-Collectible::Collectible() {}
+Collectible::Collectible()
+    : gridMinX(0), gridMinY(0), gridWidth(0), gridHeight(0)
+    , pickedUpCount(0), depositedCount(0), spinTime(0.0f)
+{
+}
 
 void Collectible::placeItems(const std::vector<std::pair<int,int>>& positions) {
-    items.clear();
-    ItemType types[] = {ItemType::KEY, ItemType::ARTIFACT, ItemType::ORB};
-    int i = 0;
-    for (auto [gx, gy] : positions) {
-        CollectibleItem item;
-        item.position = glm::vec3(
-            gx * CELL_SIZE + CELL_SIZE * 0.5f,
-            1.0f, // floating height
-            gy * CELL_SIZE + CELL_SIZE * 0.5f
-        );
-        item.size = glm::vec2(COLLECTIBLE_SIZE, COLLECTIBLE_SIZE);
-        item.type = types[i % 3];
-        item.collected = false;
-        item.pickedUp = false;
-        item.rotationAngle = 0.0f;
-        items.push_back(item);
-        i++;
+    ItemType typeCycle[] = {ItemType::KEY, ItemType::ARTIFACT, ItemType::ORB};
+    size_t n = positions.size();
+
+    posX.resize(n);
+    posY.resize(n);
+    posZ.resize(n);
+    types.resize(n);
+    flags.assign(n, 0);
+    itemCell.resize(n);
+
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (size_t i = 0; i < n; i++) {
+        auto [gx, gy] = positions[i];
+        posX[i] = gx * CELL_SIZE + CELL_SIZE * 0.5f;
+        posY[i] = 1.0f; // floating height
+        posZ[i] = gy * CELL_SIZE + CELL_SIZE * 0.5f;
+        types[i] = typeCycle[i % 3];
+        minX = std::min(minX, gx); maxX = std::max(maxX, gx);
+        minY = std::min(minY, gy); maxY = std::max(maxY, gy);
+    }
+
+    if (n == 0) { minX = minY = 0; maxX = maxY = -1; }
+    gridMinX = minX;
+    gridMinY = minY;
+    gridWidth  = maxX - minX + 1;
+    gridHeight = maxY - minY + 1;
+
+    // Counting sort of items into per-cell buckets
+    int cellCount = gridWidth * gridHeight;
+    bucketStart.assign(cellCount + 1, 0);
+    bucketLive.assign(cellCount, 0);
+    for (size_t i = 0; i < n; i++) {
+        int cx = (int)std::floor(posX[i] / CELL_SIZE);
+        int cy = (int)std::floor(posZ[i] / CELL_SIZE);
+        itemCell[i] = cellIndex(cx, cy);
+        bucketLive[itemCell[i]]++;
+    }
+    for (int c = 0; c < cellCount; c++)
+        bucketStart[c + 1] = bucketStart[c] + bucketLive[c];
+
+    bucketItems.resize(n);
+    bucketSlot.resize(n);
+    std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        int slot = fill[itemCell[i]]++;
+        bucketItems[slot] = (int)i;
+        bucketSlot[i] = slot;
     }
+
+    pickedUpCount = 0;
+    depositedCount = 0;
+    spinTime = 0.0f;
+}
+
+int Collectible::cellIndex(int cx, int cy) const {
+    int lx = cx - gridMinX;
+    int ly = cy - gridMinY;
+    if (lx < 0 || lx >= gridWidth || ly < 0 || ly >= gridHeight) return -1;
+    return ly * gridWidth + lx;
+}
+
+void Collectible::removeFromBucket(int index) {
+    int c = itemCell[index];
+
+    // Swap with the last live item of the bucket, then shrink the live range
+    int last = bucketStart[c] + bucketLive[c] - 1;
+    int slot = bucketSlot[index];
+    int other = bucketItems[last];
+    std::swap(bucketItems[slot], bucketItems[last]);
+    bucketSlot[other] = slot;
+    bucketSlot[index] = last;
+    bucketLive[c]--;
+}
+
+void Collectible::insertIntoBucket(int index) {
+    int c = itemCell[index];
+
+    // Swap with the first dead slot of the bucket, then grow the live range
+    int first = bucketStart[c] + bucketLive[c];
+    int slot = bucketSlot[index];
+    int other = bucketItems[first];
+    std::swap(bucketItems[slot], bucketItems[first]);
+    bucketSlot[other] = slot;
+    bucketSlot[index] = first;
+    bucketLive[c]++;
 }
 
 void Collectible::update(float dt) {
-    for (auto& item : items) {
-        // Only rotate items still in the world (not collected/picked up)
-        if (!item.collected && !item.pickedUp)
-            item.rotationAngle += 90.0f * dt; // degrees per second
-    }
+    // Items in the world all share one spin; carried/delivered items are
+    // never drawn spinning, so a single clock replaces per-item angles.
+    spinTime += dt;
 }
 
 bool Collectible::tryCollect(const glm::vec3& playerPos, float radius) {
     bool collected = false;
-    for (auto& item : items) {
-        if (item.collected) continue;
-        float dist = glm::length(playerPos - item.position);
-        if (dist < radius) {
-            item.collected = true;
-            collected = true;
+    int pcx = (int)std::floor(playerPos.x / CELL_SIZE);
+    int pcy = (int)std::floor(playerPos.z / CELL_SIZE);
+    int reach = (int)std::ceil(radius / CELL_SIZE);
+
+    for (int cy = pcy - reach; cy <= pcy + reach; cy++) {
+        for (int cx = pcx - reach; cx <= pcx + reach; cx++) {
+            int c = cellIndex(cx, cy);
+            if (c < 0) continue;
+            for (int s = bucketStart[c]; s < bucketStart[c] + bucketLive[c]; ) {
+                int i = bucketItems[s];
+                if (glm::length(playerPos - getPosition(i)) < radius) {
+                    removeFromBucket(i);   // moves another live item into slot s
+                    flags[i] |= FLAG_COLLECTED;
+                    depositedCount++;
+                    collected = true;
+                } else {
+                    s++;
+                }
+            }
         }
     }
     return collected;
@@ -49,52 +134,123 @@ bool Collectible::tryCollect(const glm::vec3& playerPos, float radius) {
 
 // AABB overlap pickup: returns index of first overlapping uncollected item, or -1
 int Collectible::tryPickup(const glm::vec3& playerPos, bool /*alreadyCarrying*/) {
-    // Always allow pickup regardless of carry state (stackable items)
-    for (int i = 0; i < (int)items.size(); i++) {
-        auto& item = items[i];
-        if (item.collected || item.pickedUp) continue;
-
-        // AABB overlap test between player and collectable
-        float dx = std::abs(playerPos.x - item.position.x);
-        float dy = std::abs(playerPos.y - item.position.y);
-        float dz = std::abs(playerPos.z - item.position.z);
-
-        if (dx < PICKUP_HALF_WIDTH &&
-            dy < PICKUP_HALF_HEIGHT &&
-            dz < PICKUP_HALF_WIDTH) {
-            // Mark as picked up (carried), but NOT collected yet.
-            // Items become "collected" only when deposited at the cauldron.
-            item.pickedUp = true;
-            return i;
+    // Always allow pickup regardless of carry state (stackable items).
+    // The pickup box is smaller than a cell, so only the player's cell and
+    // its direct neighbours can hold overlapping items.
+    int pcx = (int)std::floor(playerPos.x / CELL_SIZE);
+    int pcy = (int)std::floor(playerPos.z / CELL_SIZE);
+
+    int best = -1;
+    for (int cy = pcy - 1; cy <= pcy + 1; cy++) {
+        for (int cx = pcx - 1; cx <= pcx + 1; cx++) {
+            int c = cellIndex(cx, cy);
+            if (c < 0) continue;
+            for (int s = bucketStart[c]; s < bucketStart[c] + bucketLive[c]; s++) {
+                int i = bucketItems[s];
+
+                // AABB overlap test between player and collectable
+                float dx = std::abs(playerPos.x - posX[i]);
+                float dy = std::abs(playerPos.y - posY[i]);
+                float dz = std::abs(playerPos.z - posZ[i]);
+
+                if (dx < PICKUP_HALF_WIDTH &&
+                    dy < PICKUP_HALF_HEIGHT &&
+                    dz < PICKUP_HALF_WIDTH &&
+                    (best < 0 || i < best))
+                    best = i;
+            }
         }
     }
-    return -1;
-}
 
-int Collectible::getCollectedCount() const {
-    // Counts items that have been grabbed (carried) OR deposited at the cauldron,
-    // useful for the HUD progress counter.
-    int count = 0;
-    for (auto& item : items)
-        if (item.collected || item.pickedUp) count++;
-    return count;
+    if (best >= 0) {
+        // Mark as picked up (carried), but NOT collected yet.
+        // Items become "collected" only when deposited at the cauldron.
+        removeFromBucket(best);
+        flags[best] |= FLAG_PICKED_UP;
+        pickedUpCount++;
+    }
+    return best;
 }
 
-int Collectible::getDepositedCount() const {
-    int count = 0;
-    for (auto& item : items)
-        if (item.collected) count++;
-    return count;
+void Collectible::deposit(int index) {
+    if (index < 0 || index >= getTotalCount()) return;
+    if (isCollected(index)) return;
+    if (isPickedUp(index)) {
+        pickedUpCount--;
+    } else {
+        removeFromBucket(index);
+    }
+    flags[index] = FLAG_COLLECTED;
+    depositedCount++;
 }
 
-int Collectible::getTotalCount() const {
-    return (int)items.size();
+void Collectible::returnToWorld(int index) {
+    if (index < 0 || index >= getTotalCount()) return;
+    if (flags[index] != FLAG_PICKED_UP) return;
+    flags[index] = 0;
+    pickedUpCount--;
+    insertIntoBucket(index);
 }
 
 bool Collectible::allCollected() const {
     // All items must be deposited (collected=true) for win condition
-    if (getTotalCount() == 0) return false;
-    for (auto& item : items)
-        if (!item.collected) return false;
+    return getTotalCount() > 0 && depositedCount == getTotalCount();
+}
+
+bool Collectible::hasItemInCell(int cx, int cy) const {
+    int c = cellIndex(cx, cy);
+    return c >= 0 && bucketLive[c] > 0;
+}
+
+void Collectible::writeState(SnapshotWriter& out) const {
+    out.write(spinTime);
+    out.write((uint32_t)flags.size());
+    out.writeBytes(flags.data(), flags.size());
+}
+
+bool Collectible::checkState(SnapshotReader& in, const std::vector<int>& carried,
+                             int delivered) const {
+    uint32_t count = 0;
+    in.skip(sizeof(spinTime));
+    in.read(count);
+    if (!in.good() || (int)count != getTotalCount()) return false;
+    const uint8_t* payloadFlags = in.skip(count);
+    if (!payloadFlags) return false;
+
+    // Each item is in exactly one state; delivered boxes are all deposited
+    int pickedUp = 0, collected = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (payloadFlags[i] == FLAG_PICKED_UP)      pickedUp++;
+        else if (payloadFlags[i] == FLAG_COLLECTED) collected++;
+        else if (payloadFlags[i] != 0)              return false;
+    }
+    if (delivered != collected) return false;
+
+    // The carried stack is exactly the picked-up set: no strays, no repeats
+    if ((int)carried.size() != pickedUp) return false;
+    for (size_t k = 0; k < carried.size(); k++) {
+        int idx = carried[k];
+        if (idx >= (int)count || payloadFlags[idx] != FLAG_PICKED_UP) return false;
+        for (size_t j = 0; j < k; j++)
+            if (carried[j] == idx) return false;
+    }
+    return true;
+}
+
+bool Collectible::readState(SnapshotReader& in) {
+    uint32_t count = 0;
+    in.read(spinTime);
+    in.read(count);
+    if (!in.good() || (int)count != getTotalCount()) return false;
+    if (!in.readBytes(flags.data(), count)) return false;
+
+    // Recount progress and rebuild the live part of every bucket
+    pickedUpCount = depositedCount = 0;
+    std::fill(bucketLive.begin(), bucketLive.end(), 0);
+    for (int i = 0; i < getTotalCount(); i++) {
+        if (isCollected(i))      depositedCount++;
+        else if (isPickedUp(i))  pickedUpCount++;
+        else                     insertIntoBucket(i);
+    }
     return true;
 }
@@ -2,8 +2,12 @@
 #define COLLECTIBLE_H
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
+class SnapshotWriter;
+class SnapshotReader;
+
 // Collectable box dimensions in world units
 static constexpr float COLLECTIBLE_SIZE      = 0.3f;
 static constexpr float COLLECTIBLE_HALF_SIZE = COLLECTIBLE_SIZE * 0.5f;
@@ -17,21 +21,15 @@ static constexpr float CARRY_FORWARD_OFFSET  = 0.8f;   // Units in front of play
 static constexpr float CARRY_Y_OFFSET        = -0.6f;   // Units below player eye level
 static constexpr float CARRY_RIGHT_OFFSET    = 0.3f;   // Units to the right of player
 
-enum class ItemType {
+enum class ItemType : uint8_t {
     KEY,       // Golden cube
     ARTIFACT,  // Rotating pyramid
     ORB        // Sphere (rendered as low-poly icosphere)
 };
 
-struct CollectibleItem {
-    glm::vec3 position;
-    glm::vec2 size;          // Rectangular size (width, height) in world units
-    ItemType type;
-    bool collected;
-    bool pickedUp;           // Whether the item is currently carried by the player
-    float rotationAngle;
-};
-
+// Items are stored structure-of-arrays and indexed by maze cell in a
+// per-cell bucket table, so pickup only inspects the player's cell and its
+// neighbours. Progress counters are maintained incrementally.
 class Collectible {
 public:
     Collectible();
@@ -43,18 +41,68 @@ public:
     // AABB-based pickup: returns index of picked-up item, or -1 if none
     int tryPickup(const glm::vec3& playerPos, bool alreadyCarrying);
 
+    // Deliver a carried item at the exit (pickedUp -> collected)
+    void deposit(int index);
+
+    // Drop a carried item back at its original spot (pickedUp -> in world)
+    void returnToWorld(int index);
+
     // Count of items grabbed (pickedUp OR deposited) – used for HUD progress display
-    int getCollectedCount() const;
+    int getCollectedCount() const { return pickedUpCount + depositedCount; }
     // Count of items actually deposited at the cauldron (collected=true)
-    int getDepositedCount() const;
-    int getTotalCount() const;
+    int getDepositedCount() const { return depositedCount; }
+    int getTotalCount() const { return (int)posX.size(); }
     bool allCollected() const;
 
-    const std::vector<CollectibleItem>& getItems() const { return items; }
-    std::vector<CollectibleItem>& getItemsMut() { return items; }
+    // Per-item accessors
+    glm::vec3 getPosition(int index) const { return {posX[index], posY[index], posZ[index]}; }
+    ItemType getType(int index) const { return types[index]; }
+    bool isPickedUp(int index) const { return (flags[index] & FLAG_PICKED_UP) != 0; }
+    bool isCollected(int index) const { return (flags[index] & FLAG_COLLECTED) != 0; }
+    bool isInWorld(int index) const { return flags[index] == 0; }
+    // Shared spin clock of items still in the world (degrees); the renderer
+    // offsets it per item
+    float getRotation() const { return spinTime * SPIN_SPEED; }
+
+    // True if an item is still lying in maze cell (cx, cy)
+    bool hasItemInCell(int cx, int cy) const;
+
+    // Snapshot support: spin clock and per-item state flags. Positions are
+    // not stored; they are regenerated from the maze seed.
+    void writeState(SnapshotWriter& out) const;
+    bool readState(SnapshotReader& in);
+    // Dry run of readState(). Also rejects unknown flag values, a carried
+    // stack that isn't exactly the picked-up items, and a delivered count
+    // that doesn't match the deposited ones.
+    bool checkState(SnapshotReader& in, const std::vector<int>& carried, int delivered) const;
 
 private:
-    std::vector<CollectibleItem> items;
+    static constexpr uint8_t FLAG_PICKED_UP = 1;
+    static constexpr uint8_t FLAG_COLLECTED = 2;
+    static constexpr float   SPIN_SPEED     = 90.0f;  // degrees per second
+
+    // Structure-of-arrays item storage
+    std::vector<float> posX, posY, posZ;
+    std::vector<ItemType> types;
+    std::vector<uint8_t> flags;
+    std::vector<int> itemCell;       // home bucket of each item
+
+    // Per-cell buckets over the grid window covering all items. Cell c holds
+    // bucketItems[bucketStart[c] .. bucketStart[c] + bucketLive[c]); items
+    // leaving the world are swapped past the live range.
+    int gridMinX, gridMinY, gridWidth, gridHeight;
+    std::vector<int> bucketStart;
+    std::vector<int> bucketLive;
+    std::vector<int> bucketItems;
+    std::vector<int> bucketSlot;     // position of each item inside bucketItems
+
+    int pickedUpCount;
+    int depositedCount;
+    float spinTime;
+
+    int cellIndex(int cx, int cy) const;
+    void removeFromBucket(int index);
+    void insertIntoBucket(int index);
 };
 
 #endif
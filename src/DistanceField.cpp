@@ -0,0 +1,207 @@
+#include "DistanceField.h"
+#include "Maze.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+static const int INF = INT_MAX;
+static const int DX[4] = {1, -1, 0, 0};
+static const int DY[4] = {0, 0, 1, -1};
+
+DistanceField::DistanceField()
+    : width(0), height(0), goalX(0), goalY(0), maxDistance(-1)
+    , reachedOverflow(false), lastTouched(0)
+{
+}
+
+void DistanceField::build(const Maze& maze, int gx, int gy, int maxDist) {
+    width = maze.getWidth();
+    height = maze.getHeight();
+    goalX = gx;
+    goalY = gy;
+    maxDistance = maxDist;
+
+    dist.assign(width * height, INF);
+    affected.assign(width * height, 0);
+    reached.clear();
+    reachedOverflow = false;
+    heap.clear();
+    lastTouched = 0;
+
+    if (maze.isWall(goalX, goalY)) return;
+    pushHeap(0, goalY * width + goalX);
+    propagateLower(maze);
+}
+
+void DistanceField::resetDistances() {
+    if (reachedOverflow) {
+        std::fill(dist.begin(), dist.end(), INF);
+    } else {
+        for (int idx : reached) dist[idx] = INF;
+    }
+    reached.clear();
+    reachedOverflow = false;
+}
+
+void DistanceField::setGoal(const Maze& maze, int gx, int gy) {
+    if (maze.getWidth() != width || maze.getHeight() != height) {
+        build(maze, gx, gy, maxDistance);
+        return;
+    }
+    if (gx == goalX && gy == goalY) return;
+
+    goalX = gx;
+    goalY = gy;
+    rebuildFromGoal(maze);
+}
+
+// Clear only the cells the previous field reached and flood again from the
+// goal, so with a capped maxDistance a full rebuild stays local too
+void DistanceField::rebuildFromGoal(const Maze& maze) {
+    heap.clear();
+    lastTouched = (int)reached.size();
+    resetDistances();
+
+    if (maze.isWall(goalX, goalY)) return;
+    pushHeap(0, goalY * width + goalX);
+    propagateLower(maze);
+}
+
+int DistanceField::get(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return UNREACHABLE;
+    int d = dist[y * width + x];
+    return d == INF ? UNREACHABLE : d;
+}
+
+// Smallest known distance among open neighbours that are not being repaired
+int DistanceField::bestNeighbor(const Maze& maze, int x, int y) const {
+    int best = INF;
+    for (int k = 0; k < 4; k++) {
+        int nx = x + DX[k], ny = y + DY[k];
+        if (maze.isWall(nx, ny)) continue;
+        int n = ny * width + nx;
+        if (!affected[n]) best = std::min(best, dist[n]);
+    }
+    return best;
+}
+
+void DistanceField::pushHeap(int d, int idx) {
+    heap.push_back({d, idx});
+    std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<int,int>>());
+}
+
+std::pair<int,int> DistanceField::popHeap() {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<int,int>>());
+    auto top = heap.back();
+    heap.pop_back();
+    return top;
+}
+
+// Dijkstra-style wave: settles every queued cell and relaxes its neighbours
+void DistanceField::propagateLower(const Maze& maze) {
+    while (!heap.empty()) {
+        auto [d, idx] = popHeap();
+        lastTouched++;
+        if (d >= dist[idx]) continue;
+        if (dist[idx] == INF && !reachedOverflow) {
+            // Raised cells can be re-reached, so cap the list at the grid size
+            if (reached.size() < dist.size()) reached.push_back(idx);
+            else reachedOverflow = true;
+        }
+        dist[idx] = d;
+
+        if (maxDistance >= 0 && d + 1 > maxDistance) continue;
+        int x = idx % width, y = idx / width;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + DX[k], ny = y + DY[k];
+            if (maze.isWall(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (dist[n] > d + 1) pushHeap(d + 1, n);
+        }
+    }
+}
+
+void DistanceField::update(const Maze& maze,
+                           const std::vector<std::pair<int,int>>& changedCells) {
+    if (maze.getWidth() != width || maze.getHeight() != height) {
+        build(maze, goalX, goalY, maxDistance);
+        return;
+    }
+    if (maze.isWall(goalX, goalY) || dist[goalY * width + goalX] == INF) {
+        // Goal blocked or reopened: nothing local to repair
+        rebuildFromGoal(maze);
+        return;
+    }
+
+    lastTouched = 0;
+    affectedList.clear();
+    heap.clear();
+
+    // ── RAISE: find every cell whose shortest path ran through a closed cell.
+    // Candidates are visited in order of their old distance, so a cell's
+    // potential supporters (distance d-1) are already final when it is checked.
+    for (auto [cx, cy] : changedCells) {
+        if (!maze.isWall(cx, cy)) continue;
+        int idx = cy * width + cx;
+        if (dist[idx] == INF || affected[idx]) continue;
+        affected[idx] = 1;
+        affectedList.push_back(idx);
+        for (int k = 0; k < 4; k++) {
+            int nx = cx + DX[k], ny = cy + DY[k];
+            if (maze.isWall(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (!affected[n] && dist[n] == dist[idx] + 1) pushHeap(dist[n], n);
+        }
+    }
+
+    while (!heap.empty()) {
+        auto [d, idx] = popHeap();
+        lastTouched++;
+        if (affected[idx]) continue;
+
+        int x = idx % width, y = idx / width;
+        bool supported = false;
+        for (int k = 0; k < 4 && !supported; k++) {
+            int nx = x + DX[k], ny = y + DY[k];
+            if (maze.isWall(nx, ny)) continue;
+            int n = ny * width + nx;
+            supported = !affected[n] && dist[n] == d - 1;
+        }
+        if (supported) continue;
+
+        affected[idx] = 1;
+        affectedList.push_back(idx);
+        for (int k = 0; k < 4; k++) {
+            int nx = x + DX[k], ny = y + DY[k];
+            if (maze.isWall(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (!affected[n] && dist[n] == d + 1) pushHeap(d + 1, n);
+        }
+    }
+
+    // ── Reseed raised cells from the unaffected frontier
+    for (int idx : affectedList) {
+        int x = idx % width, y = idx / width;
+        if (maze.isWall(x, y)) continue;
+        int best = bestNeighbor(maze, x, y);
+        if (best != INF && (maxDistance < 0 || best + 1 <= maxDistance))
+            pushHeap(best + 1, idx);
+    }
+    for (int idx : affectedList) {
+        dist[idx] = INF;
+        affected[idx] = 0;
+    }
+
+    // ── Seed newly opened cells
+    for (auto [cx, cy] : changedCells) {
+        if (maze.isWall(cx, cy)) continue;
+        int idx = cy * width + cx;
+        if (dist[idx] != INF) continue;
+        int best = bestNeighbor(maze, cx, cy);
+        if (best != INF && (maxDistance < 0 || best + 1 <= maxDistance))
+            pushHeap(best + 1, idx);
+    }
+
+    // ── LOWER: propagate improved distances outward
+    propagateLower(maze);
+}
@@ -0,0 +1,65 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include <vector>
+#include <utility>
+
+class Maze;
+
+// Grid distance (in cells, 4-connected) from every open cell to one goal
+// cell. After walls open or close, update() repairs only the cells whose
+// shortest path changed, in the style of D* Lite: closures first RAISE the
+// cells that lost their support, then a LOWER wave re-propagates distances
+// from the surviving frontier and from newly opened cells.
+class DistanceField {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    DistanceField();
+
+    // Full rebuild from goal. maxDistance < 0 means unbounded; cells further
+    // away than maxDistance are reported as UNREACHABLE.
+    void build(const Maze& maze, int goalX, int goalY, int maxDistance = -1);
+
+    // Re-root the field at a new goal. Only cells the previous field reached
+    // are cleared, so with a capped maxDistance the cost is bounded by the
+    // area around the goal rather than by the maze size.
+    void setGoal(const Maze& maze, int goalX, int goalY);
+
+    // Repair after the listed cells changed between open and blocked
+    void update(const Maze& maze, const std::vector<std::pair<int,int>>& changedCells);
+
+    int get(int x, int y) const;
+    bool isReachable(int x, int y) const { return get(x, y) != UNREACHABLE; }
+
+    int getGoalX() const { return goalX; }
+    int getGoalY() const { return goalY; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Cells inspected by the most recent build() or update()
+    int getLastTouched() const { return lastTouched; }
+
+private:
+    int width, height;
+    int goalX, goalY;
+    int maxDistance;
+    std::vector<int> dist;          // INF for blocked / unreachable cells
+    std::vector<unsigned char> affected;
+    std::vector<int> reached;       // cells given a finite distance since the last reset
+    bool reachedOverflow;           // reached list abandoned; reset clears everything
+    int lastTouched;
+
+    // Scratch buffers reused between repairs
+    std::vector<int> affectedList;
+    std::vector<std::pair<int,int>> heap;
+
+    void resetDistances();
+    void rebuildFromGoal(const Maze& maze);
+    int bestNeighbor(const Maze& maze, int x, int y) const;
+    void pushHeap(int d, int idx);
+    std::pair<int,int> popHeap();
+    void propagateLower(const Maze& maze);
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include "DynamicWalls.h"
+#include "Maze.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+static const float CELL_SIZE = 2.0f;
+static const float PLAYER_CLEARANCE = 0.3f;   // player half-width plus margin
+static const float DOOR_REACH = CELL_SIZE * 1.25f;
+
+// Count open cells reachable from the start (4-connected flood fill)
+static int countReachable(const Maze& maze) {
+    int w = maze.getWidth(), h = maze.getHeight();
+    std::vector<unsigned char> seen(w * h, 0);
+    std::vector<int> stack;
+    auto [sx, sy] = maze.getStart();
+    stack.push_back(sy * w + sx);
+    seen[sy * w + sx] = 1;
+    int count = 0;
+    while (!stack.empty()) {
+        int idx = stack.back();
+        stack.pop_back();
+        count++;
+        int x = idx % w, y = idx / w;
+        const int dx[4] = {1, -1, 0, 0};
+        const int dy[4] = {0, 0, 1, -1};
+        for (int k = 0; k < 4; k++) {
+            int nx = x + dx[k], ny = y + dy[k];
+            if (maze.isWall(nx, ny) || seen[ny * w + nx]) continue;
+            seen[ny * w + nx] = 1;
+            stack.push_back(ny * w + nx);
+        }
+    }
+    return count;
+}
+
+DynamicWalls::DynamicWalls() : time(0.0f) {}
+
+void DynamicWalls::generate(Maze& maze) {
+    walls.clear();
+    changed.clear();
+    time = 0.0f;
+
+    int w = maze.getWidth(), h = maze.getHeight();
+    std::mt19937 rng(maze.getSeed() ^ 0x5bd1e995u);
+
+    // Candidates: open connector cells between two rooms (one odd and one
+    // even coordinate) with solid walls on the other two sides
+    std::vector<std::pair<int,int>> candidates;
+    for (int y = 1; y < h - 1; y++) {
+        for (int x = 1; x < w - 1; x++) {
+            if ((x + y) % 2 == 0 || maze.isWall(x, y)) continue;
+            bool horizontal = !maze.isWall(x - 1, y) && !maze.isWall(x + 1, y) &&
+                              maze.isWall(x, y - 1) && maze.isWall(x, y + 1);
+            bool vertical   = !maze.isWall(x, y - 1) && !maze.isWall(x, y + 1) &&
+                              maze.isWall(x - 1, y) && maze.isWall(x + 1, y);
+            if (horizontal || vertical) candidates.push_back({x, y});
+        }
+    }
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+
+    int rooms = (w / 2) * (h / 2);
+    int numPairs = rooms / 80;
+    int numDoors = std::max(1, rooms / 60);
+    int numGates = std::max(1, rooms / 40);
+    int wanted = numPairs * 2 + numDoors + numGates;
+
+    // Keep only connectors that can all be closed at once without
+    // disconnecting any open cell (i.e. each one sits on a loop)
+    int openCells = 0;
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (!maze.isWall(x, y)) openCells++;
+
+    std::vector<std::pair<int,int>> accepted;
+    for (auto [x, y] : candidates) {
+        if ((int)accepted.size() >= wanted) break;
+        maze.setCell(x, y, CellType::WALL);
+        if (countReachable(maze) == openCells - 1) {
+            accepted.push_back({x, y});
+            openCells--;
+        } else {
+            maze.setCell(x, y, CellType::PATH);
+        }
+    }
+
+    // Assign kinds: shifting pairs need two nearby connectors
+    std::uniform_real_distribution<float> periodDist(6.0f, 12.0f);
+    std::vector<bool> used(accepted.size(), false);
+    for (size_t i = 0; i < accepted.size() && numPairs > 0; i++) {
+        if (used[i]) continue;
+        for (size_t j = i + 1; j < accepted.size(); j++) {
+            if (used[j]) continue;
+            int manhattan = std::abs(accepted[i].first - accepted[j].first) +
+                            std::abs(accepted[i].second - accepted[j].second);
+            if (manhattan > 8) continue;
+
+            float period = periodDist(rng);
+            walls.push_back({accepted[i].first, accepted[i].second,
+                             DynamicWallKind::SHIFTING, false, period, 0.0f});
+            walls.push_back({accepted[j].first, accepted[j].second,
+                             DynamicWallKind::SHIFTING, false, period, period * 0.5f});
+            used[i] = used[j] = true;
+            numPairs--;
+            break;
+        }
+    }
+    for (size_t i = 0; i < accepted.size(); i++) {
+        if (used[i]) continue;
+        if (numDoors > 0) {
+            walls.push_back({accepted[i].first, accepted[i].second,
+                             DynamicWallKind::DOOR, false, 0.0f, 0.0f});
+            numDoors--;
+        } else {
+            float period = periodDist(rng);
+            std::uniform_real_distribution<float> phaseDist(0.0f, period);
+            walls.push_back({accepted[i].first, accepted[i].second,
+                             DynamicWallKind::GATE, false, period, phaseDist(rng)});
+        }
+    }
+
+    // Apply initial state (timed walls start at their phase)
+    for (auto& wall : walls) {
+        bool open = false;
+        if (wall.kind != DynamicWallKind::DOOR)
+            open = std::fmod(wall.phase, wall.period) < wall.period * 0.5f;
+        setOpen(maze, wall, open);
+    }
+    changed.clear();
+}
+
+void DynamicWalls::setOpen(Maze& maze, DynamicWall& wall, bool open) {
+    wall.open = open;
+    CellType closed = (wall.kind == DynamicWallKind::DOOR) ? CellType::DOOR : CellType::GATE;
+    maze.setCell(wall.x, wall.y, open ? CellType::PATH : closed);
+    changed.push_back({wall.x, wall.y});
+}
+
+void DynamicWalls::update(float dt, Maze& maze, const glm::vec3& playerPos, bool carryingKey) {
+    time += dt;
+
+    for (auto& wall : walls) {
+        float cx = wall.x * CELL_SIZE + CELL_SIZE * 0.5f;
+        float cz = wall.y * CELL_SIZE + CELL_SIZE * 0.5f;
+
+        bool wantOpen;
+        if (wall.kind == DynamicWallKind::DOOR) {
+            // Doors unlock for good once a key is carried up to them
+            float dx = playerPos.x - cx, dz = playerPos.z - cz;
+            wantOpen = wall.open ||
+                       (carryingKey && std::sqrt(dx * dx + dz * dz) < DOOR_REACH);
+        } else {
+            wantOpen = std::fmod(time + wall.phase, wall.period) < wall.period * 0.5f;
+        }
+        if (wantOpen == wall.open) continue;
+
+        if (!wantOpen) {
+            // Never close on top of the player
+            float half = CELL_SIZE * 0.5f + PLAYER_CLEARANCE;
+            if (std::abs(playerPos.x - cx) < half && std::abs(playerPos.z - cz) < half)
+                continue;
+        }
+        setOpen(maze, wall, wantOpen);
+    }
+}
+
+void DynamicWalls::writeState(SnapshotWriter& out) const {
+    out.write(time);
+    out.write((uint32_t)walls.size());
+    for (auto& wall : walls) out.write((uint8_t)(wall.open ? 1 : 0));
+}
+
+bool DynamicWalls::checkState(SnapshotReader& in) const {
+    uint32_t count = 0;
+    in.skip(sizeof(time));
+    in.read(count);
+    if (!in.good() || count != walls.size()) return false;
+    return in.skip(count) != nullptr;
+}
+
+bool DynamicWalls::readState(SnapshotReader& in, Maze& maze) {
+    uint32_t count = 0;
+    in.read(time);
+    in.read(count);
+    if (!in.good() || count != walls.size()) return false;
+    for (auto& wall : walls) {
+        uint8_t open = 0;
+        if (!in.read(open)) return false;
+        if ((open != 0) != wall.open) setOpen(maze, wall, open != 0);
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef DYNAMICWALLS_H
+#define DYNAMICWALLS_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+class Maze;
+class SnapshotWriter;
+class SnapshotReader;
+
+enum class DynamicWallKind : uint8_t {
+    GATE,      // opens and closes on a fixed timer
+    SHIFTING,  // one half of a pair that alternates open/closed
+    DOOR       // closed until the player arrives carrying a KEY item
+};
+
+struct DynamicWall {
+    int x, y;
+    DynamicWallKind kind;
+    bool open;
+    float period;   // seconds per full open/close cycle (timed kinds)
+    float phase;    // seconds offset into the cycle
+};
+
+// Owns every wall cell that can change during a run and writes its state
+// into the Maze grid. Walls are only placed on loop connectors whose
+// closure keeps every open cell connected, so no combination of states can
+// cut the player off from the exit or from an item.
+class DynamicWalls {
+public:
+    DynamicWalls();
+
+    // Pick gate, shifting and door cells for a freshly generated maze and
+    // apply their initial state
+    void generate(Maze& maze);
+
+    // Advance timers and unlock doors. Cells overlapping the player never
+    // close; they stay open until the player steps out.
+    void update(float dt, Maze& maze, const glm::vec3& playerPos, bool carryingKey);
+
+    // Cells whose open/closed state changed since the last clearChanges()
+    const std::vector<std::pair<int,int>>& getChangedCells() const { return changed; }
+    void clearChanges() { changed.clear(); }
+
+    // Snapshot support: timer and open/closed state per wall. The layout is
+    // regenerated from the maze seed; changed cells are queued as usual.
+    void writeState(SnapshotWriter& out) const;
+    bool readState(SnapshotReader& in, Maze& maze);
+    bool checkState(SnapshotReader& in) const;   // dry run of readState()
+
+    const std::vector<DynamicWall>& getWalls() const { return walls; }
+    float getTime() const { return time; }
+
+private:
+    std::vector<DynamicWall> walls;
+    std::vector<std::pair<int,int>> changed;
+    float time;
+
+    void setOpen(Maze& maze, DynamicWall& wall, bool open);
+};
+
+#endif
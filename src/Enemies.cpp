@@ -0,0 +1,202 @@
+#include "Enemies.h"
+#include "Maze.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+static const float CELL_SIZE = 2.0f;
+static const int MIN_SPAWN_DISTANCE = 12;   // cells from the start
+
+static const int DX[4] = {1, -1, 0, 0};
+static const int DY[4] = {0, 0, 1, -1};
+
+static uint32_t xorshift(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+Enemies::Enemies() : graceTimer(0.0f), lastUpdateMs(0.0f) {}
+
+void Enemies::spawn(const Maze& maze, int count) {
+    posX.clear(); posZ.clear(); heading.clear();
+    fromX.clear(); fromY.clear(); toX.clear(); toY.clear();
+    rngState.clear();
+    graceTimer = 0.0f;
+    lastUpdateMs = 0.0f;
+
+    auto [sx, sy] = maze.getStart();
+    chaseField.build(maze, sx, sy, ENEMY_CHASE_RADIUS);
+    if (count <= 0) return;
+
+    // Candidate rooms well away from the start (falls back to any room)
+    DistanceField fromStart;
+    fromStart.build(maze, sx, sy);
+    std::vector<std::pair<int,int>> far, any;
+    for (int y = 1; y < maze.getHeight() - 1; y += 2) {
+        for (int x = 1; x < maze.getWidth() - 1; x += 2) {
+            if (maze.isWall(x, y) || (x == sx && y == sy)) continue;
+            any.push_back({x, y});
+            if (fromStart.get(x, y) >= MIN_SPAWN_DISTANCE) far.push_back({x, y});
+        }
+    }
+    auto& cells = far.empty() ? any : far;
+    if (cells.empty()) return;
+
+    std::mt19937 rng(maze.getSeed() ^ 0x9e3779b9u);
+    std::shuffle(cells.begin(), cells.end(), rng);
+
+    for (int i = 0; i < count; i++) {
+        // More enemies than rooms: share rooms round-robin
+        auto [x, y] = cells[i % cells.size()];
+        posX.push_back(x * CELL_SIZE + CELL_SIZE * 0.5f);
+        posZ.push_back(y * CELL_SIZE + CELL_SIZE * 0.5f);
+        heading.push_back(0.0f);
+        fromX.push_back(x); fromY.push_back(y);
+        toX.push_back(x);   toY.push_back(y);
+        rngState.push_back(rng() | 1u);
+    }
+}
+
+void Enemies::onWallsChanged(const Maze& maze, const std::vector<std::pair<int,int>>& cells) {
+    if (!cells.empty()) chaseField.update(maze, cells);
+}
+
+// Called when enemy i reaches the centre of cell (toX, toY)
+void Enemies::chooseNextCell(int i, const Maze& maze) {
+    int cx = toX[i], cy = toY[i];
+    int d = chaseField.get(cx, cy);
+
+    int options[4];
+    int numOptions = 0;
+
+    if (d > 0) {
+        // Chase: any neighbour one step closer to the player
+        for (int k = 0; k < 4; k++)
+            if (chaseField.get(cx + DX[k], cy + DY[k]) == d - 1) options[numOptions++] = k;
+    } else if (d == DistanceField::UNREACHABLE) {
+        // Wander: keep going, only turn back at dead ends
+        for (int k = 0; k < 4; k++) {
+            int nx = cx + DX[k], ny = cy + DY[k];
+            if (maze.isWall(nx, ny) || (nx == fromX[i] && ny == fromY[i])) continue;
+            options[numOptions++] = k;
+        }
+        if (numOptions == 0 && !maze.isWall(fromX[i], fromY[i])) {
+            std::swap(fromX[i], toX[i]);
+            std::swap(fromY[i], toY[i]);
+            return;
+        }
+    }
+
+    fromX[i] = cx;
+    fromY[i] = cy;
+    if (numOptions > 0) {
+        int k = options[xorshift(rngState[i]) % numOptions];
+        toX[i] = cx + DX[k];
+        toY[i] = cy + DY[k];
+    }
+}
+
+bool Enemies::update(float dt, const Maze& maze, const glm::vec3& playerPos) {
+    auto start = std::chrono::steady_clock::now();
+
+    // Re-root the shared field only when the player enters a new cell
+    int pcx = (int)std::floor(playerPos.x / CELL_SIZE);
+    int pcy = (int)std::floor(playerPos.z / CELL_SIZE);
+    if (!maze.isWall(pcx, pcy))
+        chaseField.setGoal(maze, pcx, pcy);
+
+    graceTimer = std::max(0.0f, graceTimer - dt);
+    float step = ENEMY_SPEED * dt;
+    float catchSq = ENEMY_CATCH_RADIUS * ENEMY_CATCH_RADIUS;
+    bool caught = false;
+
+    int count = getCount();
+    for (int i = 0; i < count; i++) {
+        // A gate closed in front: turn back, or hold in place if boxed in
+        bool boxedIn = false;
+        if (maze.isWall(toX[i], toY[i])) {
+            boxedIn = maze.isWall(fromX[i], fromY[i]);
+            if (!boxedIn) {
+                std::swap(fromX[i], toX[i]);
+                std::swap(fromY[i], toY[i]);
+            }
+        }
+
+        if (!boxedIn) {
+            float tx = toX[i] * CELL_SIZE + CELL_SIZE * 0.5f;
+            float tz = toY[i] * CELL_SIZE + CELL_SIZE * 0.5f;
+            float dx = tx - posX[i];
+            float dz = tz - posZ[i];
+            float len = std::sqrt(dx * dx + dz * dz);
+
+            if (len <= step) {
+                posX[i] = tx;
+                posZ[i] = tz;
+                chooseNextCell(i, maze);
+            } else {
+                posX[i] += dx / len * step;
+                posZ[i] += dz / len * step;
+                heading[i] = std::atan2(dx, dz);
+            }
+        }
+
+        float px = playerPos.x - posX[i];
+        float pz = playerPos.z - posZ[i];
+        if (px * px + pz * pz < catchSq) caught = true;
+    }
+
+    caught = caught && graceTimer <= 0.0f;
+    if (caught) graceTimer = ENEMY_CATCH_GRACE;
+
+    lastUpdateMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return caught;
+}
+
+void Enemies::writeState(SnapshotWriter& out) const {
+    uint32_t count = (uint32_t)getCount();
+    out.write(count);
+    out.write(graceTimer);
+    out.writeBytes(posX.data(), count * sizeof(float));
+    out.writeBytes(posZ.data(), count * sizeof(float));
+    out.writeBytes(heading.data(), count * sizeof(float));
+    out.writeBytes(fromX.data(), count * sizeof(int));
+    out.writeBytes(fromY.data(), count * sizeof(int));
+    out.writeBytes(toX.data(), count * sizeof(int));
+    out.writeBytes(toY.data(), count * sizeof(int));
+    out.writeBytes(rngState.data(), count * sizeof(uint32_t));
+}
+
+bool Enemies::checkState(SnapshotReader& in) const {
+    uint32_t count = 0;
+    in.read(count);
+    in.skip(sizeof(graceTimer));
+    if (!in.good() || (int)count != getCount()) return false;
+    size_t perEnemy = 3 * sizeof(float) + 4 * sizeof(int) + sizeof(uint32_t);
+    return in.skip(count * perEnemy) != nullptr;
+}
+
+bool Enemies::readState(SnapshotReader& in, const Maze& maze, const glm::vec3& playerPos) {
+    uint32_t count = 0;
+    in.read(count);
+    in.read(graceTimer);
+    if (!in.good() || (int)count != getCount()) return false;
+    in.readBytes(posX.data(), count * sizeof(float));
+    in.readBytes(posZ.data(), count * sizeof(float));
+    in.readBytes(heading.data(), count * sizeof(float));
+    in.readBytes(fromX.data(), count * sizeof(int));
+    in.readBytes(fromY.data(), count * sizeof(int));
+    in.readBytes(toX.data(), count * sizeof(int));
+    in.readBytes(toY.data(), count * sizeof(int));
+    in.readBytes(rngState.data(), count * sizeof(uint32_t));
+
+    int pcx = (int)std::floor(playerPos.x / CELL_SIZE);
+    int pcy = (int)std::floor(playerPos.z / CELL_SIZE);
+    if (!maze.isWall(pcx, pcy))
+        chaseField.setGoal(maze, pcx, pcy);
+    return in.good();
+}
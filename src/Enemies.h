@@ -0,0 +1,66 @@
+#ifndef ENEMIES_H
+#define ENEMIES_H
+
+#include "DistanceField.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+class Maze;
+class SnapshotWriter;
+class SnapshotReader;
+
+// Enemy tuning
+static constexpr float ENEMY_SPEED        = 3.2f;   // units per second (player walks at 5)
+static constexpr float ENEMY_CATCH_RADIUS = 0.7f;   // XZ distance that counts as caught
+static constexpr float ENEMY_CATCH_GRACE  = 2.0f;   // seconds without catches after one
+static constexpr int   ENEMY_CHASE_RADIUS = 24;     // cells; further away enemies wander
+
+// Maze monsters that hunt the player. State is structure-of-arrays and every
+// enemy steers by the same distance field rooted at the player's cell, so
+// per-enemy cost is a handful of loads regardless of maze size. The field is
+// capped at ENEMY_CHASE_RADIUS, re-rooted only when the player changes cells
+// and repaired incrementally when doors or gates change.
+class Enemies {
+public:
+    Enemies();
+
+    // Spread count enemies over open cells far from the start
+    void spawn(const Maze& maze, int count);
+
+    // Move every enemy one step; returns true if one caught the player
+    bool update(float dt, const Maze& maze, const glm::vec3& playerPos);
+
+    // Repair the shared field after dynamic walls changed
+    void onWallsChanged(const Maze& maze, const std::vector<std::pair<int,int>>& cells);
+
+    int getCount() const { return (int)posX.size(); }
+    glm::vec3 getPosition(int index) const { return {posX[index], 0.0f, posZ[index]}; }
+    float getHeading(int index) const { return heading[index]; }
+
+    // Snapshot support: full enemy state. The shared field is re-rooted at
+    // the player's cell on load rather than stored.
+    void writeState(SnapshotWriter& out) const;
+    bool readState(SnapshotReader& in, const Maze& maze, const glm::vec3& playerPos);
+    bool checkState(SnapshotReader& in) const;   // dry run of readState()
+
+    // Wall-clock cost of the most recent update(), in milliseconds
+    float getLastUpdateMs() const { return lastUpdateMs; }
+
+private:
+    // Structure-of-arrays enemy state
+    std::vector<float> posX, posZ;
+    std::vector<float> heading;           // yaw in radians, 0 = facing +Z
+    std::vector<int> fromX, fromY;        // cell the enemy is leaving
+    std::vector<int> toX, toY;            // cell the enemy is walking to
+    std::vector<uint32_t> rngState;       // per-enemy xorshift state for wandering
+
+    DistanceField chaseField;             // shared distance to the player's cell
+    float graceTimer;
+    float lastUpdateMs;
+
+    void chooseNextCell(int index, const Maze& maze);
+};
+
+#endif
@@ -0,0 +1,128 @@
+// Headless timing harness for Enemies: spawns a crowd of enemies on a
+// generated maze, walks a stand-in player through it at walking speed while
+// gates cycle, and reports the per-tick cost of the flow-field repair plus
+// Enemies::update(). Built only with -DMAZE_RUNNER_BUILD_BENCH=ON.
+//
+// The run is deterministic, so it is repeated and each tick keeps its
+// fastest sample: that "work" figure is what the code costs, while the raw
+// worst tick also includes whatever the OS scheduler did meanwhile.
+//
+//   EnemyBench [enemies] [ticks] [maze size...]
+//   EnemyBench 500 3600 41 201
+
+#include "Maze.h"
+#include "DynamicWalls.h"
+#include "Enemies.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const float CELL_SIZE   = 2.0f;
+static const float FIXED_DT    = 1.0f / 60.0f;
+static const float WALK_SPEED  = 5.0f;    // Player::moveSpeed
+static const unsigned int SEED = 12345;
+static const int REPEATS      = 5;
+
+static const int DX[4] = {1, -1, 0, 0};
+static const int DY[4] = {0, 0, 1, -1};
+
+// One deterministic run; returns milliseconds per tick
+static std::vector<double> runOnce(int size, int enemyCount, int ticks) {
+    Maze maze(size, size, SEED);
+    maze.generate();
+    DynamicWalls walls;
+    walls.generate(maze);
+    walls.clearChanges();
+    Enemies enemies;
+    enemies.spawn(maze, enemyCount);
+
+    // The player wanders cell to cell without reversing unless stuck, which
+    // keeps re-rooting the field the way a real run does
+    std::mt19937 rng(SEED);
+    auto [sx, sy] = maze.getStart();
+    int fromX = sx, fromY = sy, toX = sx, toY = sy;
+    glm::vec3 player(sx * CELL_SIZE + CELL_SIZE * 0.5f, 0.0f, sy * CELL_SIZE + CELL_SIZE * 0.5f);
+
+    std::vector<double> samples;
+    samples.reserve(ticks);
+    for (int tick = 0; tick < ticks; tick++) {
+        glm::vec3 target(toX * CELL_SIZE + CELL_SIZE * 0.5f, 0.0f, toY * CELL_SIZE + CELL_SIZE * 0.5f);
+        glm::vec3 delta = target - player;
+        float len = glm::length(delta);
+        float step = WALK_SPEED * FIXED_DT;
+        if (len <= step || maze.isWall(toX, toY)) {
+            if (!maze.isWall(toX, toY)) player = target;
+            else { toX = fromX; toY = fromY; }
+            int options[4], numOptions = 0;
+            for (int d = 0; d < 4; d++) {
+                int nx = toX + DX[d], ny = toY + DY[d];
+                if (maze.isWall(nx, ny) || (nx == fromX && ny == fromY)) continue;
+                options[numOptions++] = d;
+            }
+            fromX = toX;
+            fromY = toY;
+            if (numOptions > 0) {
+                int d = options[rng() % numOptions];
+                toX += DX[d];
+                toY += DY[d];
+            } else {
+                std::swap(fromX, toX);
+                std::swap(fromY, toY);
+            }
+        } else {
+            player += delta / len * step;
+        }
+
+        walls.update(FIXED_DT, maze, player, false);
+
+        auto start = std::chrono::steady_clock::now();
+        if (!walls.getChangedCells().empty())
+            enemies.onWallsChanged(maze, walls.getChangedCells());
+        enemies.update(FIXED_DT, maze, player);
+        samples.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count());
+        walls.clearChanges();
+    }
+
+    return samples;
+}
+
+static void runMaze(int size, int enemyCount, int ticks) {
+    std::vector<double> work = runOnce(size, enemyCount, ticks);
+    double total = 0.0, rawWorst = 0.0;
+    for (double ms : work) { total += ms; rawWorst = std::max(rawWorst, ms); }
+    for (int r = 1; r < REPEATS; r++) {
+        std::vector<double> samples = runOnce(size, enemyCount, ticks);
+        for (int i = 0; i < ticks; i++) {
+            total += samples[i];
+            rawWorst = std::max(rawWorst, samples[i]);
+            work[i] = std::min(work[i], samples[i]);
+        }
+    }
+
+    std::sort(work.begin(), work.end());
+    std::printf("%4dx%-4d %4d enemies %6d ticks x%d: avg %.4f ms  work p99 %.4f ms  "
+                "work worst %.4f ms  raw worst %.4f ms\n",
+                size, size, enemyCount, ticks, REPEATS, total / (ticks * REPEATS),
+                work[work.size() * 99 / 100], work.back(), rawWorst);
+}
+
+int main(int argc, char** argv) {
+    int enemyCount = argc > 1 ? std::atoi(argv[1]) : 500;
+    int ticks      = argc > 2 ? std::atoi(argv[2]) : 3600;
+    std::vector<int> sizes;
+    for (int i = 3; i < argc; i++) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {41, 201};
+    if (enemyCount < 0 || ticks <= 0) {
+        std::fprintf(stderr, "usage: %s [enemies] [ticks] [maze size...]\n", argv[0]);
+        return 1;
+    }
+
+    for (int size : sizes) runMaze(size, enemyCount, ticks);
+    return 0;
+}
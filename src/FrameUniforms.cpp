@@ -0,0 +1,111 @@
+#include "FrameUniforms.h"
+#include <cstring>
+
+static_assert(sizeof(FrameUniforms::CameraBlock) == 144, "CameraBlock must match std140 FrameCamera");
+static_assert(sizeof(FrameUniforms::LightingBlock) == 80, "LightingBlock must match std140 FrameLighting");
+
+const char* const FrameUniforms::GLSL_BLOCKS = R"(
+// Per-frame blocks shared by every 3D program (FrameUniforms.h)
+layout (std140) uniform FrameCamera {
+    mat4 view;
+    mat4 projection;
+    vec3 cameraPos;
+};
+
+layout (std140) uniform FrameLighting {
+    vec3 lightDir;
+    float fogDensity;
+    vec3 fogColor;
+    float fogGradient;
+    vec3 sunColor;
+    float ambientLevel;
+    vec3 torchPos;
+    float torchRadius;
+    vec3 torchColor;
+};
+)";
+
+FrameUniforms::FrameUniforms()
+    : ubo(0), slotStride(0), cameras{}, lightings{}, boundView(-1), boundLighting(-1)
+{
+}
+
+FrameUniforms::~FrameUniforms() {
+    if (ubo) glDeleteBuffers(1, &ubo);
+}
+
+void FrameUniforms::init() {
+    // Slots are bound with glBindBufferRange, so each starts on the
+    // driver's offset alignment (commonly 256 bytes)
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    GLint largest = (GLint)sizeof(CameraBlock);
+    slotStride = (largest + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, (VIEW_COUNT + LIGHTING_COUNT) * slotStride, nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Sized once; the padding between slots stays zero
+    staging.assign((VIEW_COUNT + LIGHTING_COUNT) * slotStride, 0);
+}
+
+void FrameUniforms::setCamera(View view, const glm::mat4& viewMatrix, const glm::mat4& projection) {
+    CameraBlock& camera = cameras[view];
+    camera.view = viewMatrix;
+    camera.projection = projection;
+    glm::mat3 rotation(viewMatrix);
+    camera.cameraPos = -(glm::transpose(rotation) * glm::vec3(viewMatrix[3]));
+}
+
+void FrameUniforms::setLighting(Lighting lighting, const LightingBlock& values) {
+    lightings[lighting] = values;
+}
+
+void FrameUniforms::upload() {
+    if (!ubo) return;
+    for (int v = 0; v < VIEW_COUNT; v++)
+        std::memcpy(&staging[cameraOffset(v)], &cameras[v], sizeof(CameraBlock));
+    for (int l = 0; l < LIGHTING_COUNT; l++)
+        std::memcpy(&staging[lightingOffset(l)], &lightings[l], sizeof(LightingBlock));
+
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    // Invalidating the whole range lets the driver hand out fresh memory
+    // instead of waiting on last frame's draws, without re-specifying the
+    // buffer
+    GLsizeiptr size = (GLsizeiptr)staging.size();
+    void* dst = glMapBufferRange(GL_UNIFORM_BUFFER, 0, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (dst) {
+        std::memcpy(dst, staging.data(), size);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    } else {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, staging.data());
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    bind(VIEW_WORLD, LIGHTING_WORLD);
+}
+
+void FrameUniforms::bind(View view, Lighting lighting) {
+    if (!ubo) return;
+    if (view != boundView) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, CAMERA_BINDING, ubo, cameraOffset(view),
+                          sizeof(CameraBlock));
+        boundView = view;
+    }
+    if (lighting != boundLighting) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, LIGHTING_BINDING, ubo, lightingOffset(lighting),
+                          sizeof(LightingBlock));
+        boundLighting = lighting;
+    }
+}
+
+void FrameUniforms::attach(unsigned int program) {
+    GLuint camera = glGetUniformBlockIndex(program, "FrameCamera");
+    if (camera != GL_INVALID_INDEX) glUniformBlockBinding(program, camera, CAMERA_BINDING);
+    GLuint lighting = glGetUniformBlockIndex(program, "FrameLighting");
+    if (lighting != GL_INVALID_INDEX) glUniformBlockBinding(program, lighting, LIGHTING_BINDING);
+}
@@ -0,0 +1,84 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// World fog (exponential, see vertex.glsl)
+static constexpr float FOG_DENSITY  = 0.035f;
+static constexpr float FOG_GRADIENT = 2.0f;
+
+// Per-frame camera and lighting values shared by every 3D program through
+// std140 uniform blocks (FrameCamera, FrameLighting in the shaders). Each
+// block has a few slots: the world camera, the hands' own view and the world
+// view under the hands' projection (carried boxes), and world, hand and
+// unlit lighting. All slots go up in one upload per frame
+// and a draw group just binds the slots it wants.
+class FrameUniforms {
+public:
+    enum View { VIEW_WORLD, VIEW_HAND, VIEW_CARRIED, VIEW_COUNT };
+    enum Lighting { LIGHTING_WORLD, LIGHTING_HAND, LIGHTING_UNLIT, LIGHTING_COUNT };
+
+    // Uniform block binding points
+    static constexpr GLuint CAMERA_BINDING   = 0;
+    static constexpr GLuint LIGHTING_BINDING = 1;
+
+    // std140 mirrors: every vec3 shares its 16 bytes with the float after it
+    struct CameraBlock {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec3 cameraPos;
+        float pad;
+    };
+    struct LightingBlock {
+        glm::vec3 lightDir;
+        float fogDensity;
+        glm::vec3 fogColor;
+        float fogGradient;
+        glm::vec3 sunColor;
+        float ambientLevel;
+        glm::vec3 torchPos;
+        float torchRadius;
+        glm::vec3 torchColor;
+        float pad;                 // torch on/off picks a shader variant instead
+    };
+
+    FrameUniforms();
+    ~FrameUniforms();
+
+    void init();
+
+    void setCamera(View view, const glm::mat4& viewMatrix, const glm::mat4& projection);
+    void setLighting(Lighting lighting, const LightingBlock& values);
+
+    // Send every slot to the GPU; call once per frame after the setters
+    void upload();
+
+    // Point the shared blocks at a camera / lighting slot (no-op if current)
+    void bind(View view, Lighting lighting);
+
+    // Route a linked program's FrameCamera / FrameLighting blocks to the
+    // shared binding points
+    static void attach(unsigned int program);
+
+    // GLSL declaration of both blocks. It is inserted after #version into
+    // every 3D shader (ShaderVariants, the particle and sky programs), so the
+    // layout is written once, next to the C++ mirrors above.
+    static const char* const GLSL_BLOCKS;
+
+private:
+    unsigned int ubo;
+    GLint slotStride;          // one block plus padding to the offset alignment
+    CameraBlock cameras[VIEW_COUNT];
+    LightingBlock lightings[LIGHTING_COUNT];
+    std::vector<unsigned char> staging;   // every slot laid out as in the buffer
+    int boundView, boundLighting;
+
+    GLintptr cameraOffset(int view) const { return (GLintptr)view * slotStride; }
+    GLintptr lightingOffset(int lighting) const {
+        return (GLintptr)(VIEW_COUNT + lighting) * slotStride;
+    }
+};
+
+#endif
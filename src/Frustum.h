@@ -0,0 +1,39 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// View frustum as six planes pulled straight out of a projection * view
+// matrix (Gribb/Hartmann). Planes are not normalised; only the sign of the
+// plane distance is used.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    explicit Frustum(const glm::mat4& viewProj) {
+        // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&](int i) {
+            return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+        };
+        glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+        planes[0] = r3 + r0;   // left
+        planes[1] = r3 - r0;   // right
+        planes[2] = r3 + r1;   // bottom
+        planes[3] = r3 - r1;   // top
+        planes[4] = r3 + r2;   // near
+        planes[5] = r3 - r2;   // far
+    }
+
+    // False only if the box lies entirely outside one of the planes
+    bool intersectsBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+        for (const glm::vec4& p : planes) {
+            // Corner furthest along the plane normal
+            glm::vec3 v(p.x >= 0.0f ? boxMax.x : boxMin.x,
+                        p.y >= 0.0f ? boxMax.y : boxMin.y,
+                        p.z >= 0.0f ? boxMax.z : boxMin.z);
+            if (p.x * v.x + p.y * v.y + p.z * v.z + p.w < 0.0f) return false;
+        }
+        return true;
+    }
+};
+
+#endif
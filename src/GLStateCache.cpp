@@ -0,0 +1,86 @@
+#include "GLStateCache.h"
+
+// Impossible handle, so the first bind after invalidate() always goes out
+static const unsigned int UNKNOWN = ~0u;
+
+GLStateCache::GLStateCache()
+    : program(UNKNOWN), vao(UNKNOWN), activeUnit(-1)
+    , textureTargets{}, textures{}
+    , blend(BLEND_OFF), depthTest(true), depthWrite(true), cullFace(true)
+    , depthRangeFar(1.0f)
+    , pending{}, stats{}
+{
+    invalidate();
+}
+
+void GLStateCache::invalidate() {
+    program = UNKNOWN;
+    vao = UNKNOWN;
+    activeUnit = -1;
+    for (int u = 0; u < TEXTURE_UNITS; u++) {
+        textureTargets[u] = 0;
+        textures[u] = UNKNOWN;
+    }
+}
+
+void GLStateCache::restoreDefaults() {
+    setBlend(BLEND_OFF);
+    setDepthTest(true);
+    setDepthWrite(true);
+    setCullFace(true);
+    setDepthRangeFar(1.0f);
+}
+
+void GLStateCache::useProgram(unsigned int id) {
+    if (changed(program, id)) glUseProgram(id);
+}
+
+void GLStateCache::bindVertexArray(unsigned int id) {
+    if (changed(vao, id)) glBindVertexArray(id);
+}
+
+void GLStateCache::bindTexture(int unit, GLenum target, unsigned int texture) {
+    if (textures[unit] == texture && textureTargets[unit] == target) {
+        pending.skipped++;
+        return;
+    }
+    if (changed(activeUnit, unit)) glActiveTexture(GL_TEXTURE0 + unit);
+    textures[unit] = texture;
+    textureTargets[unit] = target;
+    pending.issued++;
+    glBindTexture(target, texture);
+}
+
+void GLStateCache::setBlend(Blend mode) {
+    Blend previous = blend;
+    if (!changed(blend, mode)) return;
+    if (mode == BLEND_OFF) { glDisable(GL_BLEND); return; }
+    if (previous == BLEND_OFF) glEnable(GL_BLEND);
+    if (mode == BLEND_ALPHA) glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    else glBlendFunc(GL_ONE, GL_ONE);
+}
+
+void GLStateCache::setDepthTest(bool enabled) {
+    if (!changed(depthTest, enabled)) return;
+    if (enabled) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+}
+
+void GLStateCache::setDepthWrite(bool enabled) {
+    if (changed(depthWrite, enabled)) glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+
+void GLStateCache::setCullFace(bool enabled) {
+    if (!changed(cullFace, enabled)) return;
+    if (enabled) glEnable(GL_CULL_FACE);
+    else glDisable(GL_CULL_FACE);
+}
+
+void GLStateCache::setDepthRangeFar(float farValue) {
+    if (changed(depthRangeFar, farValue)) glDepthRange(0.0, farValue);
+}
+
+void GLStateCache::endFrame() {
+    stats = pending;
+    pending = Stats{};
+}
@@ -0,0 +1,64 @@
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include <glad/glad.h>
+
+// Shadow copy of the GL binds and toggles the scene draws change. Each
+// setter only reaches the driver when the value differs from the last one
+// it sent, and counts the calls it skipped. Code that binds behind its back
+// must call invalidate() before the cache is used again.
+class GLStateCache {
+public:
+    enum Blend { BLEND_OFF, BLEND_ALPHA, BLEND_ADDITIVE };
+
+    static constexpr int TEXTURE_UNITS = 4;
+
+    struct Stats {
+        int issued;     // state calls that reached GL
+        int skipped;    // redundant ones dropped
+    };
+
+    GLStateCache();
+
+    // Forget the bound program, VAO and textures; toggles are left as they
+    // are, since code outside the cache restores them to the defaults
+    void invalidate();
+    // Put the toggles back to the defaults everything else relies on:
+    // opaque, depth tested and written, back faces culled, full depth range
+    void restoreDefaults();
+
+    void useProgram(unsigned int program);
+    void bindVertexArray(unsigned int vao);
+    void bindTexture(int unit, GLenum target, unsigned int texture);
+    void setBlend(Blend blend);
+    void setDepthTest(bool enabled);
+    void setDepthWrite(bool enabled);
+    void setCullFace(bool enabled);
+    void setDepthRangeFar(float farValue);
+
+    // Latch this frame's counts into getStats() and start over
+    void endFrame();
+    const Stats& getStats() const { return stats; }
+
+private:
+    unsigned int program, vao;
+    int activeUnit;
+    GLenum textureTargets[TEXTURE_UNITS];
+    unsigned int textures[TEXTURE_UNITS];
+    Blend blend;
+    bool depthTest, depthWrite, cullFace;
+    float depthRangeFar;
+
+    Stats pending, stats;
+
+    // True (and counted as issued) when current differs from value
+    template <typename T>
+    bool changed(T& current, T value) {
+        if (current == value) { pending.skipped++; return false; }
+        current = value;
+        pending.issued++;
+        return true;
+    }
+};
+
+#endif
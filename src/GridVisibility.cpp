@@ -0,0 +1,102 @@
+#include "GridVisibility.h"
+#include "Maze.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static const float CELL_SIZE = 2.0f;
+static const float CONE_MARGIN = 0.15f;     // radians added to each side of the view cone
+static const float STEEP_PITCH_XZ = 0.6f;   // below this horizontal look length, cast all around
+static const float PI = 3.14159265358979f;
+
+GridVisibility::GridVisibility()
+    : width(0), height(0), frame(0), rayCount(0), cellsVisited(0), lastUpdateMs(0.0f)
+{
+}
+
+bool GridVisibility::isPositionVisible(const glm::vec3& pos) const {
+    return isCellVisible((int)std::floor(pos.x / CELL_SIZE), (int)std::floor(pos.z / CELL_SIZE));
+}
+
+void GridVisibility::markVisible(int x, int y) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    int idx = y * width + x;
+    if (stamp[idx] == frame) return;
+    stamp[idx] = frame;
+    visibleCells.push_back(idx);
+}
+
+// Amanatides-Woo grid traversal in cell units
+void GridVisibility::castRay(const Maze& maze, float ox, float oz, float dx, float dz,
+                             float maxCells) {
+    int cx = (int)std::floor(ox), cz = (int)std::floor(oz);
+    int stepX = dx > 0.0f ? 1 : -1;
+    int stepZ = dz > 0.0f ? 1 : -1;
+    float deltaX = dx != 0.0f ? std::abs(1.0f / dx) : 1e30f;
+    float deltaZ = dz != 0.0f ? std::abs(1.0f / dz) : 1e30f;
+    float tMaxX = dx != 0.0f ? (dx > 0.0f ? (cx + 1 - ox) : (ox - cx)) * deltaX : 1e30f;
+    float tMaxZ = dz != 0.0f ? (dz > 0.0f ? (cz + 1 - oz) : (oz - cz)) * deltaZ : 1e30f;
+
+    for (;;) {
+        cellsVisited++;
+        markVisible(cx, cz);
+        if (maze.isWall(cx, cz)) return;
+
+        if (tMaxX < tMaxZ) {
+            if (tMaxX > maxCells) return;
+            cx += stepX;
+            tMaxX += deltaX;
+        } else {
+            if (tMaxZ > maxCells) return;
+            cz += stepZ;
+            tMaxZ += deltaZ;
+        }
+    }
+}
+
+void GridVisibility::update(const Maze& maze, const glm::vec3& eye, const glm::vec3& front,
+                            float halfFovX, float maxDistance) {
+    auto start = std::chrono::steady_clock::now();
+
+    if (maze.getWidth() != width || maze.getHeight() != height) {
+        width = maze.getWidth();
+        height = maze.getHeight();
+        stamp.assign(width * height, 0);
+        frame = 0;
+    }
+    if (++frame == 0) {
+        // Stamp counter wrapped: reset so stale stamps can't match
+        std::fill(stamp.begin(), stamp.end(), 0);
+        frame = 1;
+    }
+    visibleCells.clear();
+    rayCount = 0;
+    cellsVisited = 0;
+
+    float ox = eye.x / CELL_SIZE, oz = eye.z / CELL_SIZE;
+    float maxCells = maxDistance / CELL_SIZE;
+
+    // The near plane can clip into the eye's neighbours from any direction
+    int ecx = (int)std::floor(ox), ecz = (int)std::floor(oz);
+    for (int dz = -1; dz <= 1; dz++)
+        for (int dx = -1; dx <= 1; dx++)
+            markVisible(ecx + dx, ecz + dz);
+
+    // Looking steeply up or down the frustum's footprint wraps around the
+    // eye, so cast in every direction
+    float lookLen = std::sqrt(front.x * front.x + front.z * front.z);
+    float centre = std::atan2(front.z, front.x);
+    float halfCone = (lookLen < STEEP_PITCH_XZ) ? PI : std::min(PI, halfFovX + CONE_MARGIN);
+
+    // Space rays so neighbours are at most half a cell apart at full range
+    float step = 0.5f / std::max(maxCells, 1.0f);
+    int rays = (int)std::ceil(2.0f * halfCone / step) + 1;
+    for (int i = 0; i < rays; i++) {
+        float angle = centre - halfCone + 2.0f * halfCone * i / (rays - 1);
+        castRay(maze, ox, oz, std::cos(angle), std::sin(angle), maxCells);
+    }
+    rayCount = rays;
+
+    lastUpdateMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,54 @@
+#ifndef GRIDVISIBILITY_H
+#define GRIDVISIBILITY_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Maze;
+
+// Per-frame potentially-visible set over the maze grid. Walls run from floor
+// to ceiling, so occlusion is exact in 2D: rays are cast with a grid DDA
+// from the eye across the horizontal view cone and stop at the first solid
+// cell. Open cells along the way and the solid cells that stop the rays are
+// visible; everything else is hidden behind walls.
+class GridVisibility {
+public:
+    GridVisibility();
+
+    // halfFovX is the horizontal half-angle of the view (radians); rays stop
+    // after maxDistance world units
+    void update(const Maze& maze, const glm::vec3& eye, const glm::vec3& front,
+                float halfFovX, float maxDistance);
+
+    bool isCellVisible(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        return stamp[y * width + x] == frame;
+    }
+    bool isPositionVisible(const glm::vec3& pos) const;
+
+    // Visible cells as y * width + x, in discovery order
+    const std::vector<int>& getVisibleCells() const { return visibleCells; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Statistics of the most recent update()
+    int getRayCount() const { return rayCount; }
+    int getCellsVisited() const { return cellsVisited; }
+    float getLastUpdateMs() const { return lastUpdateMs; }
+
+private:
+    int width, height;
+    std::vector<uint32_t> stamp;   // == frame when visible this frame
+    uint32_t frame;
+    std::vector<int> visibleCells;
+
+    int rayCount;
+    int cellsVisited;
+    float lastUpdateMs;
+
+    void markVisible(int x, int y);
+    void castRay(const Maze& maze, float ox, float oz, float dx, float dz, float maxCells);
+};
+
+#endif
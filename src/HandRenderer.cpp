@@ -1,14 +1,19 @@
 #include "HandRenderer.h"
 #include "Shader.h"
+#include "ShaderVariants.h"
+#include "StreamBuffer.h"
+#include "RenderQueue.h"
+#include "Collectible.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
+#include <cstddef>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 HandRenderer::HandRenderer()
-    : vao(0), vbo(0), vertexCount(0)
+    : vao(0), vbo(0), stream(nullptr), vertexCount(0)
     , walkCycle(0.0f), swingAmount(0.0f)
     , bobOffset(0.0f), jumpOffset(0.0f)
 {
@@ -18,8 +23,9 @@ HandRenderer::~HandRenderer() {
     cleanup();
 }
 
-void HandRenderer::init() {
-    buildHandMesh();
+void HandRenderer::init(StreamBuffer& streamBuffer) {
+    stream = &streamBuffer;
+    buildCubeMesh();
 }
 
 void HandRenderer::cleanup() {
@@ -29,9 +35,10 @@ void HandRenderer::cleanup() {
 
 void HandRenderer::pushVertex(std::vector<float>& v,
                                float px, float py, float pz,
-                               float r, float g, float b,
-                               float nx, float ny, float nz) {
-    v.insert(v.end(), {px, py, pz, r, g, b, nx, ny, nz});
+                               float shade,
+                               float nx, float ny, float nz,
+                               float u, float tv) {
+    v.insert(v.end(), {px, py, pz, shade, shade, shade, nx, ny, nz, u, tv});
 }
 
 void HandRenderer::pushQuad(std::vector<float>& v,
@@ -39,58 +46,39 @@ void HandRenderer::pushQuad(std::vector<float>& v,
                              float x1, float y1, float z1,
                              float x2, float y2, float z2,
                              float x3, float y3, float z3,
-                             float r, float g, float b,
+                             float shade,
                              float nx, float ny, float nz) {
-    pushVertex(v, x0,y0,z0, r,g,b, nx,ny,nz);
-    pushVertex(v, x1,y1,z1, r,g,b, nx,ny,nz);
-    pushVertex(v, x2,y2,z2, r,g,b, nx,ny,nz);
-    pushVertex(v, x2,y2,z2, r,g,b, nx,ny,nz);
-    pushVertex(v, x3,y3,z3, r,g,b, nx,ny,nz);
-    pushVertex(v, x0,y0,z0, r,g,b, nx,ny,nz);
+    pushVertex(v, x0,y0,z0, shade, nx,ny,nz, 0.0f,0.0f);
+    pushVertex(v, x1,y1,z1, shade, nx,ny,nz, 1.0f,0.0f);
+    pushVertex(v, x2,y2,z2, shade, nx,ny,nz, 1.0f,1.0f);
+    pushVertex(v, x2,y2,z2, shade, nx,ny,nz, 1.0f,1.0f);
+    pushVertex(v, x3,y3,z3, shade, nx,ny,nz, 0.0f,1.0f);
+    pushVertex(v, x0,y0,z0, shade, nx,ny,nz, 0.0f,0.0f);
 }
 
-void HandRenderer::addCube(std::vector<float>& verts,
-                           float x, float y, float z,
-                           float sx, float sy, float sz,
-                           float r, float g, float b) {
-    float x0 = x, x1 = x + sx;
-    float y0 = y, y1 = y + sy;
-    float z0 = z, z1 = z + sz;
+void HandRenderer::buildCubeMesh() {
+    // Unit cube from (-0.5,-0.5,-0.5) to (0.5,0.5,0.5), same face layout and
+    // UVs as the world's gift box mesh
+    // Vertex format: pos(3) + shade(3) + normal(3) + texcoord(2) = 11 floats
+    std::vector<float> verts;
+    float x0 = -0.5f, x1 = 0.5f;
+    float y0 = -0.5f, y1 = 0.5f;
+    float z0 = -0.5f, z1 = 0.5f;
 
     // Front  (+Z)
-    pushQuad(verts, x0,y0,z1, x1,y0,z1, x1,y1,z1, x0,y1,z1, r,g,b, 0,0,1);
+    pushQuad(verts, x0,y0,z1, x1,y0,z1, x1,y1,z1, x0,y1,z1, 1.0f, 0,0,1);
     // Back   (-Z)
-    pushQuad(verts, x1,y0,z0, x0,y0,z0, x0,y1,z0, x1,y1,z0, r*0.7f,g*0.7f,b*0.7f, 0,0,-1);
+    pushQuad(verts, x1,y0,z0, x0,y0,z0, x0,y1,z0, x1,y1,z0, 0.7f, 0,0,-1);
     // Left   (-X)
-    pushQuad(verts, x0,y0,z0, x0,y0,z1, x0,y1,z1, x0,y1,z0, r*0.85f,g*0.85f,b*0.85f, -1,0,0);
+    pushQuad(verts, x0,y0,z0, x0,y0,z1, x0,y1,z1, x0,y1,z0, 0.85f, -1,0,0);
     // Right  (+X)
-    pushQuad(verts, x1,y0,z1, x1,y0,z0, x1,y1,z0, x1,y1,z1, r*0.85f,g*0.85f,b*0.85f, 1,0,0);
+    pushQuad(verts, x1,y0,z1, x1,y0,z0, x1,y1,z0, x1,y1,z1, 0.85f, 1,0,0);
     // Top    (+Y)
-    pushQuad(verts, x0,y1,z1, x1,y1,z1, x1,y1,z0, x0,y1,z0, r*1.0f,g*1.0f,b*1.0f, 0,1,0);
+    pushQuad(verts, x0,y1,z1, x1,y1,z1, x1,y1,z0, x0,y1,z0, 1.0f, 0,1,0);
     // Bottom (-Y)
-    pushQuad(verts, x0,y0,z0, x1,y0,z0, x1,y0,z1, x0,y0,z1, r*0.6f,g*0.6f,b*0.6f, 0,-1,0);
-}
-
-void HandRenderer::buildHandMesh() {
-    std::vector<float> verts;
+    pushQuad(verts, x0,y0,z0, x1,y0,z0, x1,y0,z1, x0,y0,z1, 0.6f, 0,-1,0);
 
-    // Steve-style hand: a rectangular cuboid
-    // Skin color (Steve's skin tone)
-    float skinR = 0.72f, skinG = 0.53f, skinB = 0.38f;
-    // Shirt sleeve color (cyan/teal like Steve's shirt)
-    float sleeveR = 0.25f, sleeveG = 0.65f, sleeveB = 0.65f;
-
-    // Hand (forearm + hand part)
-    // The hand mesh is centered so we can position it with transforms
-    // Forearm/sleeve part (upper portion)
-    addCube(verts, -0.15f, -0.15f, -0.6f, 0.30f, 0.30f, 0.35f,
-            sleeveR, sleeveG, sleeveB);
-
-    // Hand/skin part (lower portion, closer to camera)
-    addCube(verts, -0.15f, -0.15f, -0.25f, 0.30f, 0.30f, 0.25f,
-            skinR, skinG, skinB);
-
-    vertexCount = (int)(verts.size() / 9);
+    vertexCount = (int)(verts.size() / 11);
 
     if (vao) { glDeleteVertexArrays(1, &vao); glDeleteBuffers(1, &vbo); }
 
@@ -101,14 +89,24 @@ void HandRenderer::buildHandMesh() {
     glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
 
     // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
-    // Color
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
+    // Face shading
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     // Normal
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
     glEnableVertexAttribArray(2);
+    // Texcoord
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+
+    // Per-instance model matrix (one column per attribute) and tint; the
+    // pointers are set per draw, at this frame's offset in the stream
+    for (int a = 4; a <= 8; a++) {
+        glEnableVertexAttribArray(a);
+        glVertexAttribDivisor(a, 1);
+    }
 
     glBindVertexArray(0);
 }
@@ -145,59 +143,105 @@ void HandRenderer::update(float dt, bool moving, bool jumping, bool movingBackwa
     jumpOffset += (targetJump - jumpOffset) * lerpSpeed;
 }
 
-void HandRenderer::render(Shader& shader, float aspect) {
+glm::mat4 HandRenderer::getProjection(float aspect) {
+    // Separate projection for hands (smaller FOV to avoid distortion); the
+    // view is identity since hands are in view space
+    return glm::perspective(glm::radians(70.0f), aspect, 0.05f, 10.0f);
+}
+
+FrameUniforms::LightingBlock HandRenderer::getLighting() {
+    FrameUniforms::LightingBlock lighting{};
+    lighting.lightDir = glm::vec3(0.0f, 1.0f, 0.5f);
+    lighting.fogColor = glm::vec3(0.05f, 0.05f, 0.08f);
+    lighting.fogDensity = 0.0f;   // no fog on hands
+    lighting.fogGradient = 1.0f;
+    lighting.sunColor = glm::vec3(1.0f, 0.95f, 0.85f);
+    lighting.ambientLevel = 0.5f;
+    return lighting;
+}
+
+// Steve-style hand: a sleeve cuboid with the skin cuboid closer to the
+// camera; side is +1 for the right hand, -1 for the left
+void HandRenderer::addHand(float side) {
+    // Skin color (Steve's skin tone)
+    const glm::vec4 skin(0.72f, 0.53f, 0.38f, 0.0f);
+    // Shirt sleeve color (cyan/teal like Steve's shirt)
+    const glm::vec4 sleeve(0.25f, 0.65f, 0.65f, 0.0f);
+
+    glm::mat4 hand = glm::mat4(1.0f);
+    hand = glm::translate(hand, glm::vec3(0.45f * side, -0.45f + bobOffset + jumpOffset, -0.6f));
+    hand = glm::rotate(hand, glm::radians(-15.0f + side * swingAmount * 20.0f), glm::vec3(1, 0, 0));
+    hand = glm::rotate(hand, glm::radians(10.0f * side), glm::vec3(0, 1, 0));
+    hand = glm::scale(hand, glm::vec3(0.5f));
+
+    // Forearm/sleeve part (upper portion)
+    glm::mat4 part = glm::translate(hand, glm::vec3(0.0f, 0.0f, -0.425f));
+    instances.push_back({glm::scale(part, glm::vec3(0.30f, 0.30f, 0.35f)), sleeve});
+    // Hand/skin part (lower portion, closer to camera)
+    part = glm::translate(hand, glm::vec3(0.0f, 0.0f, -0.125f));
+    instances.push_back({glm::scale(part, glm::vec3(0.30f, 0.30f, 0.25f)), skin});
+}
+
+void HandRenderer::render(RenderQueue& queue, ShaderVariants& shaders,
+                          const glm::vec3& playerPos, const glm::vec3& playerFront,
+                          int carryCount, unsigned int materialTextures, bool torchOn) {
     if (!vao) return;
 
-    shader.use();
-
-    // Separate projection for hands (smaller FOV to avoid distortion)
-    glm::mat4 handProj = glm::perspective(glm::radians(70.0f), aspect, 0.05f, 10.0f);
-    glm::mat4 handView = glm::mat4(1.0f); // identity - hands are in view space
-
-    shader.setMat4("view", handView);
-    shader.setMat4("projection", handProj);
-    shader.setVec3("lightDir", glm::vec3(0.0f, 1.0f, 0.5f));
-    shader.setVec3("fogColor", glm::vec3(0.05f, 0.05f, 0.08f));
-    shader.setFloat("fogDensity", 0.0f); // no fog on hands
-    shader.setFloat("fogGradient", 1.0f);
-    shader.setBool("useTexture", false);
-    // Disable torch and edge outline for hands
-    shader.setBool("torchEnabled", false);
-    shader.setBool("enableEdgeOutline", false);
-    shader.setVec3("sunColor", glm::vec3(1.0f, 0.95f, 0.85f));
-    shader.setFloat("ambientLevel", 0.5f);
-
-    // Render hands with separate depth range so they're always on top
-    glDepthRange(0.0, 0.1);
-
-    // Right hand
-    {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(0.45f, -0.45f + bobOffset + jumpOffset, -0.6f));
-        model = glm::rotate(model, glm::radians(-15.0f + swingAmount * 20.0f), glm::vec3(1, 0, 0));
-        model = glm::rotate(model, glm::radians(10.0f), glm::vec3(0, 1, 0));
-        model = glm::scale(model, glm::vec3(0.5f));
-        shader.setMat4("model", model);
-
-        glBindVertexArray(vao);
-        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    instances.clear();
+    addHand(1.0f);
+    addHand(-1.0f);
+    int handCount = (int)instances.size();
+
+    // Carried stack: slightly in front, to the right, below eye level, one
+    // box every COLLECTIBLE_SIZE up
+    if (carryCount > 0) {
+        glm::vec3 flatFront = glm::normalize(glm::vec3(playerFront.x, 0.0f, playerFront.z));
+        glm::vec3 right = glm::normalize(glm::cross(flatFront, glm::vec3(0.0f, 1.0f, 0.0f)));
+        glm::vec3 basePos = playerPos
+                          + flatFront * CARRY_FORWARD_OFFSET
+                          + right * CARRY_RIGHT_OFFSET
+                          + glm::vec3(0.0f, CARRY_Y_OFFSET, 0.0f);
+        for (int i = 0; i < carryCount; i++) {
+            glm::vec3 stackPos = basePos + glm::vec3(0.0f, i * COLLECTIBLE_SIZE, 0.0f);
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), stackPos);
+            instances.push_back({glm::scale(model, glm::vec3(COLLECTIBLE_SIZE)),
+                                 glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)});
+        }
     }
 
-    // Left hand
-    {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(-0.45f, -0.45f + bobOffset + jumpOffset, -0.6f));
-        model = glm::rotate(model, glm::radians(-15.0f - swingAmount * 20.0f), glm::vec3(1, 0, 0));
-        model = glm::rotate(model, glm::radians(-10.0f), glm::vec3(0, 1, 0));
-        model = glm::scale(model, glm::vec3(0.5f));
-        shader.setMat4("model", model);
-
-        glBindVertexArray(vao);
-        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    // Both passes supply the near depth range that keeps them on top
+    submitInstances(queue, RenderQueue::PASS_VIEWMODEL, shaders.get(ShaderVariants::TEXTURE),
+                    materialTextures, 0, handCount);
+    if (carryCount > 0) {
+        unsigned features = ShaderVariants::TEXTURE | (torchOn ? ShaderVariants::TORCH : 0u);
+        submitInstances(queue, RenderQueue::PASS_CARRIED, shaders.get(features),
+                        materialTextures, handCount, carryCount);
     }
+}
 
-    glBindVertexArray(0);
-
-    // Restore default depth range
-    glDepthRange(0.0, 1.0);
+void HandRenderer::submitInstances(RenderQueue& queue, RenderQueue::Pass pass, Shader& shader,
+                                   unsigned int materialTextures, int first, int count) {
+    RenderQueue::Draw draw;
+    draw.pass = pass;
+    draw.shader = &shader;
+    draw.vao = vao;
+    draw.texture = materialTextures;
+    draw.owner = this;
+    draw.params = glm::vec4((float)first, (float)count, 0.0f, 0.0f);
+    draw.draw = [](const RenderQueue::Draw& d, Shader& shader, GLStateCache&) {
+        HandRenderer& self = *static_cast<HandRenderer*>(d.owner);
+        const Instance* records = self.instances.data() + (int)d.params.x;
+        int count = (int)d.params.y;
+        shader.setInt("materialTextures", 0);
+        GLintptr offset = self.stream->write(records, (GLsizeiptr)(count * sizeof(Instance)),
+                                             sizeof(Instance));
+        for (int c = 0; c < 4; c++) {
+            glVertexAttribPointer(4 + c, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                                  (void*)(offset + c * sizeof(glm::vec4)));
+        }
+        glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                              (void*)(offset + offsetof(Instance, tint)));
+        glDrawArraysInstanced(GL_TRIANGLES, 0, self.vertexCount, count);
+    };
+    queue.submit(draw);
 }
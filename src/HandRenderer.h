@@ -1,50 +1,79 @@
 #ifndef HANDRENDERER_H
 #define HANDRENDERER_H
 
+#include "FrameUniforms.h"
+#include "RenderQueue.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <vector>
 
 class Shader;
+class ShaderVariants;
+class StreamBuffer;
 
+// First-person viewmodel: both hands and the carried box stack, drawn as
+// instances of one textured unit cube. Hands are one call under fixed hand
+// lighting; the stack is a second call lit like the world (sun, fog,
+// torch), so its height only changes that call's instance count.
 class HandRenderer {
 public:
     HandRenderer();
     ~HandRenderer();
 
-    void init();
+    void init(StreamBuffer& stream);
     void cleanup();
 
     void update(float dt, bool moving, bool jumping, bool movingBackward);
-    void render(Shader& shader, float aspect);
+    // Hands are queued in the viewmodel pass (hand camera and lighting),
+    // the carried boxes in the carried pass: placed in the world in front
+    // of the player and lit like it, with the torch variant when it's on
+    void render(RenderQueue& queue, ShaderVariants& shaders,
+                const glm::vec3& playerPos, const glm::vec3& playerFront,
+                int carryCount, unsigned int materialTextures, bool torchOn);
+
+    // Hands live in view space under their own projection and fixed,
+    // fog-free lighting; these fill the matching FrameUniforms slots
+    static glm::mat4 getProjection(float aspect);
+    static FrameUniforms::LightingBlock getLighting();
 
 private:
+    // One record per cube drawn (viewmodel_vertex.glsl)
+    struct Instance {
+        glm::mat4 model;    // unit cube -> view space (hands) or world (boxes)
+        glm::vec4 tint;     // rgb colour, a = 1 for gift box texture, 0 for flat face shading
+    };
+
     unsigned int vao, vbo;
+    StreamBuffer* stream;   // instances are written here every draw
     int vertexCount;
+    std::vector<Instance> instances;    // capacity is kept between frames
 
     float walkCycle;     // 0 to 2π for walking animation
     float swingAmount;   // current swing offset
     float bobOffset;     // vertical bob
     float jumpOffset;    // raise when jumping
 
-    void buildHandMesh();
+    void buildCubeMesh();
+    // Record instances [first, first + count) as one draw in pass
+    void submitInstances(RenderQueue& queue, RenderQueue::Pass pass, Shader& shader,
+                         unsigned int materialTextures, int first, int count);
+    // Sleeve and skin cuboids of one hand
+    void addHand(float side);
 
-    // Push a colored cube face
+    // Push a cube face with UVs; the vertex colour holds the hand's flat
+    // per-face shading
     void pushVertex(std::vector<float>& v,
                     float px, float py, float pz,
-                    float r, float g, float b,
-                    float nx, float ny, float nz);
+                    float shade,
+                    float nx, float ny, float nz,
+                    float u, float tv);
     void pushQuad(std::vector<float>& v,
                   float x0, float y0, float z0,
                   float x1, float y1, float z1,
                   float x2, float y2, float z2,
                   float x3, float y3, float z3,
-                  float r, float g, float b,
+                  float shade,
                   float nx, float ny, float nz);
-    void addCube(std::vector<float>& v,
-                 float x, float y, float z,
-                 float sx, float sy, float sz,
-                 float r, float g, float b);
 };
 
 #endif
@@ -0,0 +1,80 @@
+#include "HudBatch.h"
+#include "Shader.h"
+#include "StreamBuffer.h"
+
+static const int INITIAL_VERTICES = 8192;
+
+HudBatch::HudBatch()
+    : stream(nullptr), vao(0)
+{
+}
+
+HudBatch::~HudBatch() {
+    cleanup();
+}
+
+void HudBatch::init(StreamBuffer& streamBuffer) {
+    stream = &streamBuffer;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->getBuffer());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    verts.reserve(INITIAL_VERTICES);
+}
+
+void HudBatch::cleanup() {
+    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
+}
+
+void HudBatch::addQuad(float x0, float y0, float x1, float y1,
+                       float r, float g, float b) {
+    appendQuad(verts, x0, y0, x1, y1, r, g, b);
+}
+
+void HudBatch::appendQuad(std::vector<Vertex>& out, float x0, float y0, float x1, float y1,
+                          float r, float g, float b) {
+    out.push_back({x0, y0, r, g, b});
+    out.push_back({x1, y0, r, g, b});
+    out.push_back({x1, y1, r, g, b});
+    out.push_back({x0, y0, r, g, b});
+    out.push_back({x1, y1, r, g, b});
+    out.push_back({x0, y1, r, g, b});
+}
+
+void HudBatch::addVertices(const std::vector<Vertex>& run) {
+    verts.insert(verts.end(), run.begin(), run.end());
+}
+
+void HudBatch::addTriangle(float x0, float y0, float x1, float y1, float x2, float y2,
+                           float r, float g, float b) {
+    verts.push_back({x0, y0, r, g, b});
+    verts.push_back({x1, y1, r, g, b});
+    verts.push_back({x2, y2, r, g, b});
+}
+
+void HudBatch::addTriangles(const std::vector<float>& xyrgb) {
+    for (size_t i = 0; i + 5 <= xyrgb.size(); i += 5)
+        verts.push_back({xyrgb[i], xyrgb[i + 1], xyrgb[i + 2], xyrgb[i + 3], xyrgb[i + 4]});
+}
+
+void HudBatch::flush(Shader& hudShader) {
+    if (verts.empty() || !stream) return;
+
+    // Vertex-aligned, so the draw starts at offset / sizeof(Vertex)
+    GLintptr offset = stream->write(verts.data(), (GLsizeiptr)(verts.size() * sizeof(Vertex)),
+                                    sizeof(Vertex));
+
+    hudShader.use();
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, (GLint)(offset / sizeof(Vertex)), (GLsizei)verts.size());
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+
+    verts.clear();
+}
@@ -0,0 +1,47 @@
+#ifndef HUD_BATCH_H
+#define HUD_BATCH_H
+
+#include <glad/glad.h>
+#include <vector>
+
+class Shader;
+class StreamBuffer;
+
+// Collects every HUD triangle of a frame (NDC position + colour) and draws
+// them with hud_vertex.glsl in a single call, streamed through the shared
+// StreamBuffer ring.
+class HudBatch {
+public:
+    struct Vertex {
+        float x, y;         // NDC
+        float r, g, b;
+    };
+
+    HudBatch();
+    ~HudBatch();
+
+    void init(StreamBuffer& stream);
+    void cleanup();
+
+    void addQuad(float x0, float y0, float x1, float y1,
+                 float r, float g, float b);
+    // Append a quad's two triangles to out (for vertex runs kept elsewhere)
+    static void appendQuad(std::vector<Vertex>& out, float x0, float y0, float x1, float y1,
+                           float r, float g, float b);
+    // Copy in a prebuilt run, e.g. cached text
+    void addVertices(const std::vector<Vertex>& run);
+    void addTriangle(float x0, float y0, float x1, float y1, float x2, float y2,
+                     float r, float g, float b);
+    // Triangles in the x, y, r, g, b float layout of the StarRating.h helpers
+    void addTriangles(const std::vector<float>& xyrgb);
+
+    // Draw everything added since the last flush, then start over
+    void flush(Shader& hudShader);
+
+private:
+    std::vector<Vertex> verts;      // this frame's vertices; capacity is kept
+    StreamBuffer* stream;
+    unsigned int vao;               // reads the stream buffer from offset 0
+};
+
+#endif
@@ -8,6 +8,7 @@ Maze::Maze(int width, int height, unsigned int seed)
     if (seed == 0)
         seed = static_cast<unsigned int>(
             std::chrono::steady_clock::now().time_since_epoch().count());
+    this->seed = seed;
     rng.seed(seed);
 }
 
@@ -41,7 +42,12 @@ CellType Maze::getCell(int x, int y) const {
 }
 
 bool Maze::isWall(int x, int y) const {
-    return getCell(x, y) == CellType::WALL;
+    return getCell(x, y) != CellType::PATH;
+}
+
+void Maze::setCell(int x, int y, CellType type) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    grid[y][x] = type;
 }
 
 std::pair<int,int> Maze::getExit() const {
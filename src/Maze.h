@@ -7,7 +7,9 @@
 
 enum class CellType : uint8_t {
     WALL = 0,
-    PATH = 1
+    PATH = 1,
+    DOOR = 2,   // closed key door (opens permanently)
+    GATE = 3    // closed timed gate / shifting wall section
 };
 
 class Maze {
@@ -16,7 +18,10 @@ public:
 
     void generate();
     CellType getCell(int x, int y) const;
+    // Closed doors and gates block movement like walls
     bool isWall(int x, int y) const;
+    void setCell(int x, int y, CellType type);
+    unsigned int getSeed() const { return seed; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
 
@@ -30,6 +35,7 @@ public:
 
 private:
     int width, height;
+    unsigned int seed;
     std::vector<std::vector<CellType>> grid;
     std::mt19937 rng;
 
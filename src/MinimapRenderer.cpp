@@ -0,0 +1,193 @@
+#include "MinimapRenderer.h"
+#include "Maze.h"
+#include "Shader.h"
+#include <algorithm>
+#include <cmath>
+
+static const float CELL_SIZE = 2.0f;
+
+// Corner map layout, in pixels
+static const float MAP_RADIUS = 90.0f;
+static const float MAP_MARGIN = 20.0f;
+static const float MAP_CELL_PIXELS = 12.0f;
+// Overview panel side as a fraction of the smaller screen dimension
+static const float OVERVIEW_FRACTION = 0.8f;
+// Cells around the player marked explored on entering a cell
+static const int REVEAL_RADIUS = 3;
+
+MinimapRenderer::MinimapRenderer()
+    : vao(0), mazeTexture(0), exploredTexture(0), width(0), height(0)
+    , lastCellX(-1), lastCellY(-1)
+    , mazeMipsDirty(false), exploredMipsDirty(false), overview(false)
+{
+}
+
+MinimapRenderer::~MinimapRenderer() {
+    cleanup();
+}
+
+void MinimapRenderer::init() {
+    shader = std::make_unique<Shader>("shaders/minimap_vertex.glsl",
+                                      "shaders/minimap_fragment.glsl");
+    shader->use();
+    shader->setInt("mazeMap", 0);
+    shader->setInt("exploredMap", 1);
+
+    // Core profile needs a bound VAO even when no attributes are read
+    glGenVertexArrays(1, &vao);
+    mazeTexture = createCellTexture();
+    exploredTexture = createCellTexture();
+}
+
+void MinimapRenderer::cleanup() {
+    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
+    if (mazeTexture) { glDeleteTextures(1, &mazeTexture); mazeTexture = 0; }
+    if (exploredTexture) { glDeleteTextures(1, &exploredTexture); exploredTexture = 0; }
+    shader.reset();
+}
+
+unsigned int MinimapRenderer::createCellTexture() {
+    unsigned int tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    // The corner map uses texelFetch; only the overview filters, and it
+    // shrinks the maze, so minification goes through the mips
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return tex;
+}
+
+void MinimapRenderer::setMaze(const Maze& maze) {
+    width = maze.getWidth();
+    height = maze.getHeight();
+    std::vector<uint8_t> open(width * height);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            open[y * width + x] = maze.isWall(x, y) ? 0 : 255;
+    explored.assign(width * height, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, mazeTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0,
+                 GL_RED, GL_UNSIGNED_BYTE, open.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, exploredTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0,
+                 GL_RED, GL_UNSIGNED_BYTE, explored.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    mazeMipsDirty = false;
+    exploredMipsDirty = false;
+    lastCellX = lastCellY = -1;
+}
+
+void MinimapRenderer::updateCells(const Maze& maze,
+                                  const std::vector<std::pair<int,int>>& cells) {
+    if (cells.empty()) return;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, mazeTexture);
+    for (auto [x, y] : cells) {
+        if (x < 0 || y < 0 || x >= width || y >= height) continue;
+        uint8_t open = maze.isWall(x, y) ? 0 : 255;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RED, GL_UNSIGNED_BYTE, &open);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // Mips are rebuilt only when the overview next needs them
+    mazeMipsDirty = true;
+}
+
+void MinimapRenderer::reveal(const glm::vec3& playerPos) {
+    int cx = (int)std::floor(playerPos.x / CELL_SIZE);
+    int cy = (int)std::floor(playerPos.z / CELL_SIZE);
+    if ((cx == lastCellX && cy == lastCellY) || explored.empty()) return;
+    lastCellX = cx;
+    lastCellY = cy;
+
+    int x0 = std::max(cx - REVEAL_RADIUS, 0), x1 = std::min(cx + REVEAL_RADIUS, width - 1);
+    int y0 = std::max(cy - REVEAL_RADIUS, 0), y1 = std::min(cy + REVEAL_RADIUS, height - 1);
+    if (x0 > x1 || y0 > y1) return;
+
+    bool changed = false;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int dx = x - cx, dy = y - cy;
+            if (dx * dx + dy * dy > REVEAL_RADIUS * REVEAL_RADIUS) continue;
+            uint8_t& cell = explored[y * width + x];
+            if (!cell) { cell = 255; changed = true; }
+        }
+    }
+    if (!changed) return;
+
+    // Upload just the revealed block, straight out of the CPU mirror
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    glBindTexture(GL_TEXTURE_2D, exploredTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x0, y0, x1 - x0 + 1, y1 - y0 + 1,
+                    GL_RED, GL_UNSIGNED_BYTE, &explored[y0 * width + x0]);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    exploredMipsDirty = true;
+}
+
+void MinimapRenderer::render(const glm::vec3& playerPos, float playerYaw,
+                             const glm::vec3& exitWorldPos, int scrW, int scrH) {
+    if (!shader || !width) return;
+
+    // Panel centre and half extent in pixels, and the size of one cell
+    glm::vec2 centre;
+    float halfSize, cellPixels;
+    if (overview) {
+        halfSize = std::min(scrW, scrH) * OVERVIEW_FRACTION * 0.5f;
+        centre = glm::vec2(scrW * 0.5f, scrH * 0.5f);
+        cellPixels = 2.0f * halfSize / (float)std::max(width, height);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mazeTexture);
+        if (mazeMipsDirty) { glGenerateMipmap(GL_TEXTURE_2D); mazeMipsDirty = false; }
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, exploredTexture);
+        if (exploredMipsDirty) { glGenerateMipmap(GL_TEXTURE_2D); exploredMipsDirty = false; }
+    } else {
+        halfSize = MAP_RADIUS;
+        centre = glm::vec2(scrW - MAP_RADIUS - MAP_MARGIN, scrH - MAP_RADIUS - MAP_MARGIN);
+        cellPixels = MAP_CELL_PIXELS;
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, mazeTexture);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, exploredTexture);
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    // Bounding square of the panel in NDC
+    glm::vec2 lo = (centre - halfSize) / glm::vec2(scrW, scrH) * 2.0f - 1.0f;
+    glm::vec2 hi = (centre + halfSize) / glm::vec2(scrW, scrH) * 2.0f - 1.0f;
+
+    // North-up map; only the arrow turns with the player
+    float yaw = glm::radians(playerYaw);
+    glm::vec2 dir = glm::normalize(glm::vec2(std::cos(yaw), -std::sin(yaw)));
+
+    shader->use();
+    shader->setVec4("panelRect", glm::vec4(lo, hi));
+    shader->setVec2("panelCentre", centre);
+    shader->setFloat("panelRadius", halfSize);
+    shader->setFloat("cellPixels", cellPixels);
+    shader->setIVec2("mazeSize", width, height);
+    shader->setVec2("playerCell", glm::vec2(playerPos.x, playerPos.z) / CELL_SIZE);
+    shader->setVec2("exitCell", glm::vec2(exitWorldPos.x, exitWorldPos.z) / CELL_SIZE);
+    shader->setVec2("playerDir", dir);
+    shader->setBool("overview", overview);
+
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,54 @@
+#ifndef MINIMAP_RENDERER_H
+#define MINIMAP_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Maze;
+class Shader;
+
+// Minimap drawn as a single quad by minimap_fragment.glsl. The maze lives
+// in an R8 texture (one texel per cell, open = 1) uploaded once per maze and
+// patched when doors/gates change; fog-of-war is a second R8 texture of
+// explored cells, written only when the player enters a new cell. The
+// corner map fetches exact cells; the full-map overview samples both
+// textures through their mip pyramids, so huge mazes cost one quad too.
+class MinimapRenderer {
+public:
+    MinimapRenderer();
+    ~MinimapRenderer();
+
+    void init();
+    void cleanup();
+
+    // Upload a new maze and forget everything explored
+    void setMaze(const Maze& maze);
+    // Re-upload cells whose type changed (doors opening, gates moving)
+    void updateCells(const Maze& maze, const std::vector<std::pair<int,int>>& cells);
+    // Mark cells around the player explored; no-op until the cell changes
+    void reveal(const glm::vec3& playerPos);
+
+    void toggleOverview() { overview = !overview; }
+    bool isOverview() const { return overview; }
+
+    // Draw the corner map, or the overview panel when it's toggled on
+    void render(const glm::vec3& playerPos, float playerYaw,
+                const glm::vec3& exitWorldPos, int scrW, int scrH);
+
+private:
+    std::unique_ptr<Shader> shader;
+    unsigned int vao;                   // attribute-less; corners from gl_VertexID
+    unsigned int mazeTexture, exploredTexture;
+    int width, height;
+    std::vector<uint8_t> explored;      // CPU mirror of exploredTexture
+    int lastCellX, lastCellY;           // cell the last reveal ran for
+    bool mazeMipsDirty, exploredMipsDirty;
+    bool overview;
+
+    static unsigned int createCellTexture();
+};
+
+#endif
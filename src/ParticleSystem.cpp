@@ -0,0 +1,147 @@
+#include "ParticleSystem.h"
+#include "Shader.h"
+#include "StreamBuffer.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Per-instance attribute arrays, at locations 1 + their index
+enum InstanceArray {
+    ARRAY_POS_X, ARRAY_POS_Y, ARRAY_POS_Z,
+    ARRAY_SIZE, ARRAY_LIFE, ARRAY_MAX_LIFE, ARRAY_COLOR,
+    ARRAY_COUNT
+};
+
+static uint32_t packColor(const glm::vec3& c) {
+    auto channel = [](float v) {
+        return (uint32_t)(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(c.r) | (channel(c.g) << 8) | (channel(c.b) << 16) | (255u << 24);
+}
+
+ParticleSystem::ParticleSystem(Space space, int capacity)
+    : space(space), capacity(capacity), count(0), gravity(0.0f)
+    , posX(capacity), posY(capacity), posZ(capacity)
+    , velX(capacity), velY(capacity), velZ(capacity)
+    , life(capacity), maxLife(capacity), size(capacity), color(capacity)
+    , stream(nullptr), vao(0), quadVBO(0)
+{
+}
+
+ParticleSystem::~ParticleSystem() {
+    cleanup();
+}
+
+void ParticleSystem::init(StreamBuffer& streamBuffer) {
+    stream = &streamBuffer;
+
+    // Unit quad corners, drawn as a strip
+    const float corners[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &quadVBO);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Instance attribute pointers are set per draw, at this frame's offsets
+    for (int a = 0; a < ARRAY_COUNT; a++) {
+        glEnableVertexAttribArray(1 + a);
+        glVertexAttribDivisor(1 + a, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
+void ParticleSystem::cleanup() {
+    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
+    if (quadVBO) { glDeleteBuffers(1, &quadVBO); quadVBO = 0; }
+}
+
+bool ParticleSystem::spawn(const glm::vec3& pos, const glm::vec3& vel, float lifetime,
+                           float particleSize, const glm::vec3& rgb) {
+    if (count >= capacity) return false;
+    int i = count++;
+    posX[i] = pos.x; posY[i] = pos.y; posZ[i] = pos.z;
+    velX[i] = vel.x; velY[i] = vel.y; velZ[i] = vel.z;
+    life[i] = lifetime;
+    maxLife[i] = lifetime;
+    size[i] = particleSize;
+    color[i] = packColor(rgb);
+    return true;
+}
+
+void ParticleSystem::burst(const glm::vec3& centre, int n, float speed, float lifetime,
+                           float particleSize, const glm::vec3& rgb) {
+    for (int p = 0; p < n; p++) {
+        float angle = p * 2.0f * (float)M_PI / n;
+        glm::vec3 vel = (space == SCREEN)
+            ? glm::vec3(std::cos(angle) * speed, std::sin(angle) * speed, 0.0f)
+            : glm::vec3(std::cos(angle) * speed, speed * 1.5f, std::sin(angle) * speed);
+        if (!spawn(centre, vel, lifetime, particleSize, rgb)) return;
+    }
+}
+
+// Move the last live particle into slot i
+void ParticleSystem::kill(int i) {
+    int last = --count;
+    posX[i] = posX[last]; posY[i] = posY[last]; posZ[i] = posZ[last];
+    velX[i] = velX[last]; velY[i] = velY[last]; velZ[i] = velZ[last];
+    life[i] = life[last];
+    maxLife[i] = maxLife[last];
+    size[i] = size[last];
+    color[i] = color[last];
+}
+
+void ParticleSystem::update(float dt) {
+    // Branch-free passes over contiguous arrays
+    float dv = gravity * dt;
+    for (int i = 0; i < count; i++) velY[i] -= dv;
+    for (int i = 0; i < count; i++) posX[i] += velX[i] * dt;
+    for (int i = 0; i < count; i++) posY[i] += velY[i] * dt;
+    for (int i = 0; i < count; i++) posZ[i] += velZ[i] * dt;
+    for (int i = 0; i < count; i++) life[i] -= dt;
+
+    // Backwards, so a particle swapped in from the end was already checked
+    for (int i = count - 1; i >= 0; i--)
+        if (life[i] <= 0.0f) kill(i);
+}
+
+void ParticleSystem::render(RenderQueue& queue, Shader& particleShader) {
+    if (count == 0 || !vao) return;
+
+    RenderQueue::Draw draw;
+    draw.pass = (space == SCREEN) ? RenderQueue::PASS_OVERLAY : RenderQueue::PASS_ADDITIVE;
+    draw.shader = &particleShader;
+    draw.vao = vao;
+    draw.owner = this;
+    draw.draw = [](const RenderQueue::Draw& d, Shader& shader, GLStateCache&) {
+        ParticleSystem& self = *static_cast<ParticleSystem*>(d.owner);
+        // Every array is 4 bytes per particle
+        const void* arrays[ARRAY_COUNT] = {
+            self.posX.data(), self.posY.data(), self.posZ.data(),
+            self.size.data(), self.life.data(), self.maxLife.data(), self.color.data()
+        };
+        GLsizeiptr arrayBytes = (GLsizeiptr)self.count * 4;
+        GLintptr base = self.stream->allocate(arrayBytes * ARRAY_COUNT, 4);
+        for (int a = 0; a < ARRAY_COUNT; a++) {
+            GLintptr offset = base + a * arrayBytes;
+            self.stream->upload(offset, arrays[a], arrayBytes);
+            if (a == ARRAY_COLOR)
+                glVertexAttribPointer(1 + a, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4, (void*)offset);
+            else
+                glVertexAttribPointer(1 + a, 1, GL_FLOAT, GL_FALSE, 4, (void*)offset);
+        }
+
+        shader.setBool("screenSpace", self.space == SCREEN);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, self.count);
+    };
+    queue.submit(draw);
+}
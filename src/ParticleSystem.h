@@ -0,0 +1,72 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Shader;
+class StreamBuffer;
+class RenderQueue;
+
+// Fixed-capacity particle pool stored structure-of-arrays. Spawning appends
+// at the live count and a dead particle is replaced by the last live one,
+// so both are O(1) and nothing is allocated after construction. The update
+// loops are plain per-array passes the compiler vectorises. Every live
+// particle is drawn as a quad instance in one call (particle_vertex.glsl):
+// SCREEN pools live in NDC (win-screen star bursts), WORLD pools are
+// camera-facing billboards under the shared FrameCamera block (pickup and
+// delivery effects).
+class ParticleSystem {
+public:
+    enum Space { SCREEN, WORLD };
+
+    ParticleSystem(Space space, int capacity);
+    ~ParticleSystem();
+
+    void init(StreamBuffer& stream);
+    void cleanup();
+
+    // Returns false (and drops the particle) when the pool is full
+    bool spawn(const glm::vec3& pos, const glm::vec3& vel, float life,
+               float size, const glm::vec3& color);
+    // count particles flying out evenly around a ring: in the screen plane
+    // for SCREEN pools, horizontally with an upward kick for WORLD pools
+    void burst(const glm::vec3& centre, int count, float speed, float life,
+               float size, const glm::vec3& color);
+
+    // Integrate, age and retire dead particles
+    void update(float dt);
+    void clear() { count = 0; }
+    int getCount() const { return count; }
+
+    // Downward acceleration (units/s²), WORLD effects only
+    void setGravity(float g) { gravity = g; }
+
+    // Queue one instanced draw, additively blended so particles fade out by
+    // colour (the additive pass for WORLD pools, the overlay pass for SCREEN)
+    void render(RenderQueue& queue, Shader& particleShader);
+
+private:
+    Space space;
+    int capacity;
+    int count;
+    float gravity;
+
+    // Structure-of-arrays state; size == capacity, first count are live
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> life, maxLife, size;
+    std::vector<uint32_t> color;        // RGBA8
+
+    // Instances come from the shared stream: the live prefix of every array
+    // is copied as its own block of one allocation, so nothing is
+    // interleaved on the CPU
+    StreamBuffer* stream;
+    unsigned int vao, quadVBO;
+
+    void kill(int i);
+};
+
+#endif
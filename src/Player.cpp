@@ -1,5 +1,6 @@
 #include "Player.h"
 #include "Maze.h"
+#include "Snapshot.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 
@@ -123,3 +124,45 @@ void Player::update(float dt, const Maze& maze, bool moveForward, bool moveBack,
         onGround = true;
     }
 }
+
+void Player::writeState(SnapshotWriter& out) const {
+    out.write(position);
+    out.write(yaw);
+    out.write(pitch);
+    out.write(velocityY);
+    out.write((uint8_t)(onGround ? 1 : 0));
+    out.write((uint16_t)carriedItems.size());
+    for (int idx : carriedItems) out.write((uint16_t)idx);
+}
+
+bool Player::checkState(SnapshotReader& in, std::vector<int>& carried) {
+    uint16_t count = 0;
+    in.skip(sizeof(position) + sizeof(yaw) + sizeof(pitch) + sizeof(velocityY) + sizeof(uint8_t));
+    in.read(count);
+    carried.clear();
+    for (int i = 0; i < count && in.good(); i++) {
+        uint16_t idx = 0;
+        in.read(idx);
+        carried.push_back(idx);
+    }
+    return in.good();
+}
+
+bool Player::readState(SnapshotReader& in) {
+    uint8_t ground = 0;
+    uint16_t carried = 0;
+    in.read(position);
+    in.read(yaw);
+    in.read(pitch);
+    in.read(velocityY);
+    in.read(ground);
+    in.read(carried);
+    onGround = ground != 0;
+    carriedItems.clear();
+    for (int i = 0; i < carried && in.good(); i++) {
+        uint16_t idx = 0;
+        in.read(idx);
+        carriedItems.push_back(idx);
+    }
+    return in.good();
+}
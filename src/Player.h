@@ -5,6 +5,8 @@
 #include <vector>
 
 class Maze;
+class SnapshotWriter;
+class SnapshotReader;
 
 class Player {
 public:
@@ -28,6 +30,12 @@ public:
 
     bool isOnGround() const { return onGround; }
 
+    // Snapshot support: physics state and carried stack
+    void writeState(SnapshotWriter& out) const;
+    bool readState(SnapshotReader& in);
+    // Dry run of readState(): validates and collects the carried indices
+    static bool checkState(SnapshotReader& in, std::vector<int>& carried);
+
 private:
     float moveSpeed;
     float mouseSensitivity;
@@ -0,0 +1,112 @@
+#include "RenderQueue.h"
+#include "Shader.h"
+#include <algorithm>
+
+// Fixed state of each pass
+struct PassState {
+    GLStateCache::Blend blend;
+    bool depthWrite;
+    bool depthTest;
+    float depthRangeFar;
+    FrameUniforms::View view;
+    FrameUniforms::Lighting lighting;
+    bool backToFront;
+};
+
+static const PassState PASS_STATES[RenderQueue::PASS_COUNT] = {
+    // OPAQUE
+    {GLStateCache::BLEND_OFF, true, true, 1.0f,
+     FrameUniforms::VIEW_WORLD, FrameUniforms::LIGHTING_WORLD, false},
+    // GLOW
+    {GLStateCache::BLEND_OFF, true, true, 1.0f,
+     FrameUniforms::VIEW_WORLD, FrameUniforms::LIGHTING_UNLIT, false},
+    // DECAL
+    {GLStateCache::BLEND_ALPHA, false, true, 1.0f,
+     FrameUniforms::VIEW_WORLD, FrameUniforms::LIGHTING_WORLD, true},
+    // ADDITIVE
+    {GLStateCache::BLEND_ADDITIVE, false, true, 1.0f,
+     FrameUniforms::VIEW_WORLD, FrameUniforms::LIGHTING_WORLD, false},
+    // VIEWMODEL: a separate depth range so it's always on top
+    {GLStateCache::BLEND_OFF, true, true, 0.1f,
+     FrameUniforms::VIEW_HAND, FrameUniforms::LIGHTING_HAND, false},
+    // CARRIED: same projection and depth range as the hands, so the two
+    // depth-test against each other, but lit and fogged like the world
+    {GLStateCache::BLEND_OFF, true, true, 0.1f,
+     FrameUniforms::VIEW_CARRIED, FrameUniforms::LIGHTING_WORLD, false},
+    // OVERLAY
+    {GLStateCache::BLEND_ADDITIVE, false, false, 1.0f,
+     FrameUniforms::VIEW_WORLD, FrameUniforms::LIGHTING_WORLD, false},
+};
+
+// Key layout, high to low: pass (4 bits), then program, texture and VAO
+// names (12 bits each) and a 24-bit depth; back-to-front passes put the
+// (inverted) depth right after the pass instead
+static const int NAME_BITS = 12;
+static const int DEPTH_BITS = 24;
+static const float DEPTH_RANGE = 256.0f;    // world units; farther clamps
+
+RenderQueue::RenderQueue()
+    : cameraPos(0.0f), pendingDraws(0), stats{}
+{
+}
+
+uint64_t RenderQueue::sortKey(const Draw& draw) const {
+    const uint64_t nameMask = (1u << NAME_BITS) - 1;
+    const uint64_t depthMax = (1u << DEPTH_BITS) - 1;
+
+    float distance = glm::length(draw.position - cameraPos);
+    uint64_t depth = (uint64_t)(std::min(distance / DEPTH_RANGE, 1.0f) * depthMax);
+    uint64_t state = ((uint64_t)(draw.shader->ID & nameMask) << (2 * NAME_BITS))
+                   | ((uint64_t)(draw.texture & nameMask) << NAME_BITS)
+                   | (uint64_t)(draw.vao & nameMask);
+
+    uint64_t key = (uint64_t)draw.pass << 60;
+    if (PASS_STATES[draw.pass].backToFront)
+        return key | ((depthMax - depth) << (3 * NAME_BITS)) | state;
+    return key | (state << DEPTH_BITS) | depth;
+}
+
+void RenderQueue::submit(const Draw& draw) {
+    if (!draw.shader || !draw.draw) return;
+    draws.push_back(draw);
+}
+
+void RenderQueue::flush(FrameUniforms& frameUniforms) {
+    if (draws.empty()) return;
+
+    order.clear();
+    for (uint32_t i = 0; i < (uint32_t)draws.size(); i++)
+        order.push_back({sortKey(draws[i]), i});
+    std::sort(order.begin(), order.end());
+
+    state.invalidate();
+    for (auto& entry : order) {
+        Draw& draw = draws[entry.second];
+        const PassState& pass = PASS_STATES[draw.pass];
+
+        state.setBlend(pass.blend);
+        state.setDepthTest(pass.depthTest);
+        state.setDepthWrite(pass.depthWrite);
+        state.setDepthRangeFar(pass.depthRangeFar);
+        state.setCullFace(draw.cullFace);
+        frameUniforms.bind(pass.view, pass.lighting);
+
+        state.useProgram(draw.shader->ID);
+        state.bindVertexArray(draw.vao);
+        if (draw.texture) state.bindTexture(0, draw.textureTarget, draw.texture);
+        draw.draw(draw, *draw.shader, state);
+    }
+
+    state.restoreDefaults();
+    state.bindVertexArray(0);
+
+    pendingDraws += (int)draws.size();
+    draws.clear();     // keeps its capacity for the next frame
+}
+
+void RenderQueue::endFrame() {
+    state.endFrame();
+    stats.draws = pendingDraws;
+    stats.state = state.getStats();
+    pendingDraws = 0;
+}
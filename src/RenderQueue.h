@@ -0,0 +1,92 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include "FrameUniforms.h"
+#include "GLStateCache.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Shader;
+
+// Scene draws are recorded during the frame instead of issued on the spot,
+// then sorted by a 64-bit key (pass, program, texture, VAO, depth) and
+// submitted through a GLStateCache, so draws sharing a program, texture or
+// VAO run back to back and their binds go out once. Opaque passes sort by
+// state and then front-to-back; the decal pass sorts back-to-front first.
+class RenderQueue {
+public:
+    // Submission order; the pass fixes blending, depth and the FrameUniforms
+    // slots its draws use. Every depth-writing world pass comes before the
+    // blended ones, so blended draws test against the finished depth buffer.
+    enum Pass {
+        PASS_OPAQUE,        // maze, items, enemies, exit
+        PASS_GLOW,          // unlit torch glow sprite
+        PASS_DECAL,         // alpha blended, no depth write (graffiti)
+        PASS_ADDITIVE,      // additive, no depth write (world sparks)
+        PASS_VIEWMODEL,     // hand camera and lighting, near depth range
+        PASS_CARRIED,       // carried boxes: hand projection, world lighting, near depth range
+        PASS_OVERLAY,       // screen space, additive, no depth test (win bursts)
+        PASS_COUNT
+    };
+
+    struct Stats {
+        int draws;          // submitted during the last finished frame
+        GLStateCache::Stats state;
+    };
+
+    struct Draw;
+
+    // Sets the draw's own uniforms from its payload and issues its GL draw
+    // call(s); the program, VAO and unit 0 texture are already bound. Any
+    // other texture goes through the cache as well. A plain function (a
+    // capture-less lambda converts), so recording a draw never allocates.
+    using DrawFn = void (*)(const Draw& draw, Shader& shader, GLStateCache& state);
+
+    struct Draw {
+        Pass pass = PASS_OPAQUE;
+        Shader* shader = nullptr;
+        unsigned int vao = 0;
+        GLenum textureTarget = GL_TEXTURE_2D_ARRAY;   // unit 0; texture 0 binds nothing
+        unsigned int texture = 0;
+        glm::vec3 position = glm::vec3(0.0f);         // world position, for depth order
+        bool cullFace = true;
+        DrawFn draw = nullptr;
+
+        // Payload for draw: the object that recorded it, plus a per-object
+        // transform and four free values
+        void* owner = nullptr;
+        glm::mat4 model = glm::mat4(1.0f);
+        glm::vec4 params = glm::vec4(0.0f);
+    };
+
+    RenderQueue();
+
+    // Eye position the depth part of the key is measured from
+    void setCamera(const glm::vec3& eye) { cameraPos = eye; }
+
+    void submit(const Draw& draw);
+
+    // Sort and issue everything recorded since the last flush. Binds left
+    // by code outside the queue are forgotten first, and the default
+    // toggles are back in place afterwards.
+    void flush(FrameUniforms& frameUniforms);
+
+    // Latch this frame's draw and state counts into getStats()
+    void endFrame();
+    const Stats& getStats() const { return stats; }
+
+private:
+    glm::vec3 cameraPos;
+    std::vector<Draw> draws;
+    std::vector<std::pair<uint64_t, uint32_t>> order;   // (key, index into draws)
+    GLStateCache state;
+    int pendingDraws;
+    Stats stats;
+
+    uint64_t sortKey(const Draw& draw) const;
+};
+
+#endif
@@ -1,10 +1,18 @@
 #include "Renderer.h"
 #include "Maze.h"
 #include "Collectible.h"
+#include "Enemies.h"
 #include "Shader.h"
+#include "ShaderVariants.h"
+#include "Frustum.h"
+#include "FrameUniforms.h"
+#include "StreamBuffer.h"
+#include "RenderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -14,6 +22,20 @@
 static const float CELL_SIZE = 2.0f;
 static const float WALL_HEIGHT = 4.0f;
 
+// Past MAZE_CULL_DISTANCE the fog visibility exp(-(d * density)^gradient)
+// falls below 1/256, so geometry there is pure fog colour and maze chunks
+// beyond it are skipped.
+static const float MAZE_CULL_DISTANCE =
+    std::pow(std::log(256.0f), 1.0f / FOG_GRADIENT) / FOG_DENSITY;   // ~67 units
+
+// Texture array layers (must match the vertex shaders). Graffiti variants
+// follow from LAYER_GRAFFITI on.
+static const int LAYER_WALL     = 0;
+static const int LAYER_GROUND   = 1;
+static const int LAYER_GIFT_BOX = 2;
+static const int LAYER_GRAFFITI = 3;
+static const int MAX_LAYER_SIZE = 512;   // larger PNG overrides are downsampled
+
 // Graffiti texture filenames - add more by dropping files into textures/graffiti/
 const std::vector<std::string> Renderer::GRAFFITI_FILES = {
     "graffiti_01.png",
@@ -24,48 +46,48 @@ const std::vector<std::string> Renderer::GRAFFITI_FILES = {
 };
 
 Renderer::Renderer()
-    : mazeVAO(0), mazeVBO(0), mazeVertexCount(0)
-    , groundVAO(0), groundVBO(0), groundVertexCount(0)
+    : mazeChunksX(0), mazeChunksY(0), mazeVAO(0), mazeVBO(0), mazeEBO(0), visibilityValid(false)
+    , mazeRenderMode(MazeRenderMode::MESH), gridTextureID(0), gridVAO(0), gridWidth(0), gridHeight(0)
     , cubeVAO(0), cubeVBO(0), cubeVertexCount(0)
     , pyramidVAO(0), pyramidVBO(0), pyramidVertexCount(0)
     , sphereVAO(0), sphereVBO(0), sphereVertexCount(0)
-    , giftBoxVAO(0), giftBoxVBO(0), giftBoxVertexCount(0), giftBoxTextureID(0)
-    , wallTextureID(0), groundTextureID(0)
+    , giftBoxVAO(0), giftBoxVBO(0), giftBoxVertexCount(0)
+    , stream(nullptr)
+    , exitVAO(0), exitInstanceVBO(0), exitInstanceCount(0)
+    , exitBoundsMin(0.0f), exitBoundsMax(0.0f)
+    , enemyVAO(0), enemyVBO(0), enemyVertexCount(0)
+    , materialArrayID(0), materialLayerSize(0), graffitiLayerCount(0)
     , graffitiVAO(0), graffitiVBO(0), graffitiVertexCount(0)
-    , scratchVAO(0), scratchVBO(0)
     , wireframe(false)
+    , torchLit(false)
 {
 }
 
 Renderer::~Renderer() {
-    if (mazeVAO) { glDeleteVertexArrays(1, &mazeVAO); glDeleteBuffers(1, &mazeVBO); }
-    if (groundVAO) { glDeleteVertexArrays(1, &groundVAO); glDeleteBuffers(1, &groundVBO); }
+    destroyMazeChunks();
+    if (gridTextureID) { glDeleteTextures(1, &gridTextureID); }
+    if (gridVAO) { glDeleteVertexArrays(1, &gridVAO); }
     if (cubeVAO) { glDeleteVertexArrays(1, &cubeVAO); glDeleteBuffers(1, &cubeVBO); }
     if (pyramidVAO) { glDeleteVertexArrays(1, &pyramidVAO); glDeleteBuffers(1, &pyramidVBO); }
     if (sphereVAO) { glDeleteVertexArrays(1, &sphereVAO); glDeleteBuffers(1, &sphereVBO); }
     if (giftBoxVAO) { glDeleteVertexArrays(1, &giftBoxVAO); glDeleteBuffers(1, &giftBoxVBO); }
-    if (giftBoxTextureID) { glDeleteTextures(1, &giftBoxTextureID); }
-    if (wallTextureID) { glDeleteTextures(1, &wallTextureID); }
-    if (groundTextureID) { glDeleteTextures(1, &groundTextureID); }
+    if (enemyVAO) { glDeleteVertexArrays(1, &enemyVAO); glDeleteBuffers(1, &enemyVBO); }
+    if (materialArrayID) { glDeleteTextures(1, &materialArrayID); }
     if (graffitiVAO) { glDeleteVertexArrays(1, &graffitiVAO); glDeleteBuffers(1, &graffitiVBO); }
-    for (auto id : graffitiTextureIDs) {
-        if (id) glDeleteTextures(1, &id);
-    }
-    if (scratchVAO) { glDeleteVertexArrays(1, &scratchVAO); glDeleteBuffers(1, &scratchVBO); }
+    if (exitVAO) { glDeleteVertexArrays(1, &exitVAO); glDeleteBuffers(1, &exitInstanceVBO); }
 }
 
-void Renderer::init() {
-    generateWallTexture();
-    generateGroundTexture();
-    generateGiftBoxTexture();
-    generateGraffitiTextures();
+void Renderer::init(StreamBuffer& streamBuffer) {
+    stream = &streamBuffer;
+    buildMaterialArray();
     buildCubeMesh();
     buildPyramidMesh();
     buildSphereMesh();
     buildGiftBoxMesh();
-    // Create scratch VAO for cauldron rendering
-    glGenVertexArrays(1, &scratchVAO);
-    glGenBuffers(1, &scratchVBO);
+    buildEnemyMesh();
+    buildExitZoneMesh();
+    // Attribute-less VAO for grid vertex pulling (core profile needs one bound)
+    glGenVertexArrays(1, &gridVAO);
 }
 
 void Renderer::setWireframe(bool enabled) {
@@ -179,147 +201,366 @@ void Renderer::addCube(std::vector<float>& verts,
     pushQuad(verts, x0,y0,z0, x1,y0,z0, x1,y0,z1, x0,y0,z1, r,g,b, 0,-1,0);
 }
 
-void Renderer::buildMazeMesh(const Maze& maze) {
-    std::vector<float> wallVerts;
-    std::vector<float> groundVerts;
+// Packed maze vertex (8 bytes). Corners of maze faces always sit on the
+// cell grid at floor or ceiling height with an axis-aligned normal, so the
+// vertex stores integers only; maze_vertex.glsl rebuilds world position,
+// normal, UVs and base colour from them.
+struct MazeVertex {
+    uint16_t gridX, gridZ;   // cell corner coordinates
+    uint8_t level;           // 0 = floor, 1 = ceiling height
+    uint8_t normal;          // MAZE_NORMAL_* index
+    uint8_t material;        // MAT_* id
+    uint8_t pad;
+};
+static_assert(sizeof(MazeVertex) == 8, "MazeVertex must stay tightly packed");
+
+// Normal indices (must match maze_vertex.glsl)
+static const uint8_t MAZE_NORMAL_POS_X = 0;
+static const uint8_t MAZE_NORMAL_NEG_X = 1;
+static const uint8_t MAZE_NORMAL_POS_Y = 2;
+static const uint8_t MAZE_NORMAL_NEG_Y = 3;
+static const uint8_t MAZE_NORMAL_POS_Z = 4;
+static const uint8_t MAZE_NORMAL_NEG_Z = 5;
+
+// Material ids (must match maze_vertex.glsl / fragment.glsl). STONE and
+// GRASS get their per-cell colour variation in the fragment shader, so runs
+// of neighbouring cells can be merged into one quad.
+static const uint8_t MAT_CEILING = 0;
+static const uint8_t MAT_STONE   = 1;
+static const uint8_t MAT_GRASS   = 2;
+static const uint8_t MAT_DOOR    = 3;
+static const uint8_t MAT_GATE    = 4;
+
+static void setupMazeVertexLayout() {
+    // Grid corner
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_SHORT, sizeof(MazeVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    // Level, normal index, material id
+    glVertexAttribIPointer(1, 3, GL_UNSIGNED_BYTE, sizeof(MazeVertex),
+                           (void*)offsetof(MazeVertex, level));
+    glEnableVertexAttribArray(1);
+}
 
-    int w = maze.getWidth();
-    int h = maze.getHeight();
+// Helper: add a maze quad as four vertices and six indices. Corners are
+// (gridX, gridZ, level) listed counter-clockwise.
+static void pushMazeQuad(std::vector<MazeVertex>& verts, std::vector<uint16_t>& indices,
+                         const int (&c)[4][3], uint8_t normal, uint8_t material) {
+    uint16_t base = (uint16_t)verts.size();
+    for (auto& corner : c) {
+        verts.push_back({(uint16_t)corner[0], (uint16_t)corner[1], (uint8_t)corner[2],
+                         normal, material, 0});
+    }
+    const uint16_t order[6] = {0, 1, 2, 2, 3, 0};
+    for (uint16_t i : order) indices.push_back(base + i);
+}
 
-    for (int y = 0; y < h; y++) {
-        for (int x = 0; x < w; x++) {
-            float wx = x * CELL_SIZE;
-            float wz = y * CELL_SIZE;
+static uint8_t wallMaterial(CellType cell) {
+    if (cell == CellType::DOOR) return MAT_DOOR;   // locked door: dark oak planks
+    if (cell == CellType::GATE) return MAT_GATE;   // closed gate: cold iron
+    return MAT_STONE;
+}
 
-            if (maze.isWall(x, y)) {
-                // Minecraft stone brick walls with color variation
-                unsigned int hash = (unsigned int)(x * 7919 + y * 104729);
-                hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
-                hash = (hash >> 16) ^ hash;
-                float variation = (float)(hash % 100) / 500.0f;
-
-                // Choose between stone brick variants
-                float wr, wg, wb;
-                int variant = hash % 5;
-                if (variant == 0) {
-                    // Mossy stone brick (greenish)
-                    wr = 0.35f + variation; wg = 0.42f + variation; wb = 0.30f + variation;
-                } else if (variant == 1) {
-                    // Cobblestone (lighter gray)
-                    wr = 0.50f + variation; wg = 0.48f + variation; wb = 0.45f + variation;
-                } else {
-                    // Standard stone brick
-                    wr = 0.45f + variation; wg = 0.43f + variation; wb = 0.40f + variation;
+void Renderer::destroyMazeChunks() {
+    if (mazeVAO) {
+        glDeleteVertexArrays(1, &mazeVAO);
+        glDeleteBuffers(1, &mazeVBO);
+        glDeleteBuffers(1, &mazeEBO);
+        mazeVAO = mazeVBO = mazeEBO = 0;
+    }
+    mazeChunks.clear();
+    mazeChunksX = mazeChunksY = 0;
+}
+
+// Mesh one chunk: walls, ceilings and floors in a single stream (the
+// shaders pick the texture layer from the material)
+void Renderer::buildChunkMesh(const Maze& maze, const MazeChunk& chunk,
+                              std::vector<MazeVertex>& verts, std::vector<uint16_t>& indices) const {
+    verts.clear();
+    indices.clear();
+
+    int x0 = chunk.cellX0, y0 = chunk.cellY0;
+    int x1 = std::min(x0 + MAZE_CHUNK_SIZE, maze.getWidth());
+    int y1 = std::min(y0 + MAZE_CHUNK_SIZE, maze.getHeight());
+
+    // ── Wall sides ──────────────────────────────────────────────
+    // Only faces of solid cells that border an open cell are emitted (no
+    // buried faces, bottoms, tops or outer boundary), and runs of equal
+    // faces along a row or column merge into one quad per run.
+    struct Side { int dx, dy; uint8_t normal; };
+    const Side sides[4] = {
+        { 0,  1, MAZE_NORMAL_POS_Z},   // front
+        { 0, -1, MAZE_NORMAL_NEG_Z},   // back
+        {-1,  0, MAZE_NORMAL_NEG_X},   // left
+        { 1,  0, MAZE_NORMAL_POS_X},   // right
+    };
+    for (const Side& side : sides) {
+        bool alongX = (side.dy != 0);   // ±Z faces run along X
+        int lines0 = alongX ? y0 : x0, lines1 = alongX ? y1 : x1;
+        int run0 = alongX ? x0 : y0, run1 = alongX ? x1 : y1;
+
+        for (int line = lines0; line < lines1; line++) {
+            int start = run0;
+            CellType startType = CellType::PATH;
+            for (int i = run0; i <= run1; i++) {
+                // PATH means "no face here"; it also terminates the last run
+                CellType type = CellType::PATH;
+                if (i < run1) {
+                    int x = alongX ? i : line, y = alongX ? line : i;
+                    CellType cell = maze.getCell(x, y);
+                    if (cell != CellType::PATH && !maze.isWall(x + side.dx, y + side.dy))
+                        type = cell;
                 }
-                addCubeTextured(wallVerts, wx, 0.0f, wz, CELL_SIZE, WALL_HEIGHT, CELL_SIZE,
-                        wr, wg, wb);
-            } else {
-                // Minecraft grass block floor
-                unsigned int fhash = (unsigned int)(x * 3571 + y * 7907);
-                fhash = ((fhash >> 16) ^ fhash) * 0x45d9f3b;
-                fhash = (fhash >> 16) ^ fhash;
-                float fvar = (float)(fhash % 100) / 600.0f;
-                // Grass green color with variation
-                float fr = 0.28f + fvar * 0.5f;
-                float fg = 0.45f + fvar;
-                float fb = 0.18f + fvar * 0.3f;
-
-                // Floor (textured)
-                pushQuadUV(groundVerts,
-                    wx,         0.0f, wz,
-                    wx+CELL_SIZE, 0.0f, wz,
-                    wx+CELL_SIZE, 0.0f, wz+CELL_SIZE,
-                    wx,         0.0f, wz+CELL_SIZE,
-                    fr, fg, fb,
-                    0.0f, 1.0f, 0.0f,
-                    0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f);
-                // Ceiling (dark stone, textured)
-                pushQuadUV(wallVerts,
-                    wx,         WALL_HEIGHT, wz+CELL_SIZE,
-                    wx+CELL_SIZE, WALL_HEIGHT, wz+CELL_SIZE,
-                    wx+CELL_SIZE, WALL_HEIGHT, wz,
-                    wx,         WALL_HEIGHT, wz,
-                    0.12f, 0.12f, 0.15f,
-                    0.0f, -1.0f, 0.0f,
-                    0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f);
+                if (type == startType) continue;
+
+                if (startType != CellType::PATH) {
+                    // Emit [start, i) in the grid plane on the open side,
+                    // wound counter-clockwise as seen from that side
+                    int plane = line + (side.dx + side.dy > 0 ? 1 : 0);
+                    bool reversed = (side.dy < 0) || (side.dx > 0);
+                    int a = reversed ? i : start, b = reversed ? start : i;
+                    int c[4][3] = {{a, plane, 0}, {b, plane, 0}, {b, plane, 1}, {a, plane, 1}};
+                    if (!alongX)
+                        for (auto& corner : c) std::swap(corner[0], corner[1]);
+                    pushMazeQuad(verts, indices, c, side.normal, wallMaterial(startType));
+                }
+                start = i;
+                startType = type;
             }
         }
     }
 
-    // Stride is 11 floats: pos(3) + color(3) + normal(3) + texcoord(2)
-    mazeVertexCount = (int)(wallVerts.size() / 11);
-    groundVertexCount = (int)(groundVerts.size() / 11);
+    // ── Floors and ceilings ─────────────────────────────────────
+    // Greedy rectangles over the open cells of the chunk
+    int cw = x1 - x0, ch = y1 - y0;
+    std::vector<unsigned char> done(cw * ch, 0);
+    auto open = [&](int x, int y) {
+        return !done[(y - y0) * cw + (x - x0)] && !maze.isWall(x, y);
+    };
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            if (!open(x, y)) continue;
+
+            int xe = x + 1;
+            while (xe < x1 && open(xe, y)) xe++;
+            int ye = y + 1;
+            for (; ye < y1; ye++) {
+                bool full = true;
+                for (int k = x; k < xe && full; k++) full = open(k, ye);
+                if (!full) break;
+            }
+            for (int j = y; j < ye; j++)
+                for (int k = x; k < xe; k++) done[(j - y0) * cw + (k - x0)] = 1;
+
+            // Grass floor
+            const int floorCorners[4][3] = {{x, y, 0}, {xe, y, 0}, {xe, ye, 0}, {x, ye, 0}};
+            pushMazeQuad(verts, indices, floorCorners, MAZE_NORMAL_POS_Y, MAT_GRASS);
+            // Ceiling (dark stone)
+            const int ceilCorners[4][3] = {{x, ye, 1}, {xe, ye, 1}, {xe, y, 1}, {x, y, 1}};
+            pushMazeQuad(verts, indices, ceilCorners, MAZE_NORMAL_NEG_Y, MAT_CEILING);
+        }
+    }
+}
 
-    if (mazeVAO) { glDeleteVertexArrays(1, &mazeVAO); glDeleteBuffers(1, &mazeVBO); }
-    if (groundVAO) { glDeleteVertexArrays(1, &groundVAO); glDeleteBuffers(1, &groundVBO); }
+// Mesh every chunk into the shared buffers. Each slice gets a quarter extra
+// room so opening or closing a door can remesh in place; an edit that
+// outgrows its slice comes back here.
+void Renderer::uploadMazeChunks(const Maze& maze) {
+    std::vector<std::vector<MazeVertex>> chunkVerts(mazeChunks.size());
+    std::vector<std::vector<uint16_t>> chunkIndices(mazeChunks.size());
+    int totalVertices = 0, totalIndices = 0;
+    for (size_t i = 0; i < mazeChunks.size(); i++) {
+        MazeChunk& chunk = mazeChunks[i];
+        buildChunkMesh(maze, chunk, chunkVerts[i], chunkIndices[i]);
+        int quads = (int)chunkVerts[i].size() / 4;
+        int quadCapacity = quads + quads / 4 + 8;
+        chunk.baseVertex = totalVertices;
+        chunk.vertexCapacity = quadCapacity * 4;
+        chunk.firstIndex = totalIndices;
+        chunk.indexCapacity = quadCapacity * 6;
+        chunk.indexCount = (int)chunkIndices[i].size();
+        totalVertices += chunk.vertexCapacity;
+        totalIndices += chunk.indexCapacity;
+    }
 
-    glGenVertexArrays(1, &mazeVAO);
-    glGenBuffers(1, &mazeVBO);
+    if (!mazeVAO) {
+        glGenVertexArrays(1, &mazeVAO);
+        glGenBuffers(1, &mazeVBO);
+        glGenBuffers(1, &mazeEBO);
+        glBindVertexArray(mazeVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mazeVBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mazeEBO);
+        setupMazeVertexLayout();
+    } else {
+        glBindVertexArray(mazeVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, mazeVBO);
+    }
+    glBufferData(GL_ARRAY_BUFFER, totalVertices * sizeof(MazeVertex), nullptr, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalIndices * sizeof(uint16_t), nullptr, GL_STATIC_DRAW);
+    for (size_t i = 0; i < mazeChunks.size(); i++) {
+        const MazeChunk& chunk = mazeChunks[i];
+        glBufferSubData(GL_ARRAY_BUFFER, chunk.baseVertex * sizeof(MazeVertex),
+                        chunkVerts[i].size() * sizeof(MazeVertex), chunkVerts[i].data());
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, chunk.firstIndex * sizeof(uint16_t),
+                        chunkIndices[i].size() * sizeof(uint16_t), chunkIndices[i].data());
+    }
+    glBindVertexArray(0);
+}
 
-    glBindVertexArray(mazeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, mazeVBO);
-    glBufferData(GL_ARRAY_BUFFER, wallVerts.size() * sizeof(float), wallVerts.data(), GL_STATIC_DRAW);
+void Renderer::buildMazeMesh(const Maze& maze) {
+    destroyMazeChunks();
+    uploadGridTexture(maze);
+
+    mazeChunksX = (maze.getWidth() + MAZE_CHUNK_SIZE - 1) / MAZE_CHUNK_SIZE;
+    mazeChunksY = (maze.getHeight() + MAZE_CHUNK_SIZE - 1) / MAZE_CHUNK_SIZE;
+    mazeChunks.resize(mazeChunksX * mazeChunksY);
+
+    for (int cy = 0; cy < mazeChunksY; cy++) {
+        for (int cx = 0; cx < mazeChunksX; cx++) {
+            MazeChunk& chunk = mazeChunks[cy * mazeChunksX + cx];
+            chunk = MazeChunk{};
+            chunk.cellX0 = cx * MAZE_CHUNK_SIZE;
+            chunk.cellY0 = cy * MAZE_CHUNK_SIZE;
+            int cellX1 = std::min(chunk.cellX0 + MAZE_CHUNK_SIZE, maze.getWidth());
+            int cellY1 = std::min(chunk.cellY0 + MAZE_CHUNK_SIZE, maze.getHeight());
+            chunk.boundsMin = glm::vec3(chunk.cellX0 * CELL_SIZE, 0.0f, chunk.cellY0 * CELL_SIZE);
+            chunk.boundsMax = glm::vec3(cellX1 * CELL_SIZE, WALL_HEIGHT, cellY1 * CELL_SIZE);
+        }
+    }
+    // Grid mode draws straight from the grid texture: no meshing
+    if (mazeRenderMode == MazeRenderMode::MESH) uploadMazeChunks(maze);
 
-    // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Color
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // Normal
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    // TexCoord
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    // Build graffiti decals on maze walls
+    buildGraffitiMesh(maze);
+    visibilityValid = false;
+}
 
-    glBindVertexArray(0);
+// One byte per cell holding its CellType, read by maze_grid_vertex.glsl
+void Renderer::uploadGridTexture(const Maze& maze) {
+    gridWidth = maze.getWidth();
+    gridHeight = maze.getHeight();
+    std::vector<uint8_t> cells(gridWidth * gridHeight);
+    for (int y = 0; y < gridHeight; y++)
+        for (int x = 0; x < gridWidth; x++)
+            cells[y * gridWidth + x] = (uint8_t)maze.getCell(x, y);
+
+    if (!gridTextureID) {
+        glGenTextures(1, &gridTextureID);
+        glBindTexture(GL_TEXTURE_2D, gridTextureID);
+        // Integer textures can't be filtered
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, gridTextureID);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, gridWidth, gridHeight, 0,
+                 GL_RED_INTEGER, GL_UNSIGNED_BYTE, cells.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    glGenVertexArrays(1, &groundVAO);
-    glGenBuffers(1, &groundVBO);
+void Renderer::setMazeRenderMode(MazeRenderMode mode, const Maze& maze) {
+    if (mode == mazeRenderMode) return;
+    mazeRenderMode = mode;
 
-    glBindVertexArray(groundVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, groundVBO);
-    glBufferData(GL_ARRAY_BUFFER, groundVerts.size() * sizeof(float), groundVerts.data(), GL_STATIC_DRAW);
+    if (mode == MazeRenderMode::MESH) {
+        uploadMazeChunks(maze);
+        return;
+    }
+    // Grid mode needs only the texture: free the chunk meshes
+    if (mazeVAO) {
+        glDeleteVertexArrays(1, &mazeVAO);
+        glDeleteBuffers(1, &mazeVBO);
+        glDeleteBuffers(1, &mazeEBO);
+        mazeVAO = mazeVBO = mazeEBO = 0;
+    }
+    for (auto& chunk : mazeChunks) chunk.indexCount = 0;
+}
 
-    // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Color
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // Normal
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    // TexCoord
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+void Renderer::updateVisibility(const Maze& maze, const glm::vec3& eye, const glm::vec3& front,
+                                const glm::mat4& projection) {
+    // projection[0][0] = 1 / tan(halfFovX)
+    float halfFovX = std::atan(1.0f / projection[0][0]);
+    visibility.update(maze, eye, front, halfFovX, MAZE_CULL_DISTANCE);
+    visibilityValid = true;
+
+    chunkHasVisibleCell.assign(mazeChunks.size(), 0);
+    if (mazeChunksX == 0) return;
+    for (int idx : visibility.getVisibleCells()) {
+        int x = idx % visibility.getWidth(), y = idx / visibility.getWidth();
+        chunkHasVisibleCell[(y / MAZE_CHUNK_SIZE) * mazeChunksX + x / MAZE_CHUNK_SIZE] = 1;
+    }
+}
 
-    glBindVertexArray(0);
+void Renderer::updateMazeCells(const Maze& maze, const std::vector<std::pair<int,int>>& cells) {
+    // The grid texture takes a single texel write per changed cell
+    if (gridTextureID) {
+        glBindTexture(GL_TEXTURE_2D, gridTextureID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (auto [x, y] : cells) {
+            uint8_t type = (uint8_t)maze.getCell(x, y);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, &type);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    if (mazeChunks.empty() || mazeRenderMode != MazeRenderMode::MESH) return;
+
+    // A cell edit can change the faces of its neighbours too, so the chunks
+    // of all four neighbours are remeshed as well
+    std::vector<bool> dirty(mazeChunks.size(), false);
+    const int dx[5] = {0, 1, -1, 0, 0};
+    const int dy[5] = {0, 0, 0, 1, -1};
+    for (auto [x, y] : cells) {
+        for (int k = 0; k < 5; k++) {
+            int nx = x + dx[k], ny = y + dy[k];
+            if (nx < 0 || ny < 0 || nx >= maze.getWidth() || ny >= maze.getHeight()) continue;
+            dirty[(ny / MAZE_CHUNK_SIZE) * mazeChunksX + nx / MAZE_CHUNK_SIZE] = true;
+        }
+    }
 
-    // Build graffiti decals on maze walls
-    buildGraffitiMesh(maze);
+    std::vector<MazeVertex> verts;
+    std::vector<uint16_t> indices;
+    glBindVertexArray(mazeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mazeVBO);
+    for (size_t i = 0; i < mazeChunks.size(); i++) {
+        if (!dirty[i]) continue;
+        MazeChunk& chunk = mazeChunks[i];
+        buildChunkMesh(maze, chunk, verts, indices);
+        if ((int)verts.size() > chunk.vertexCapacity || (int)indices.size() > chunk.indexCapacity) {
+            // Outgrew its slice: lay the whole buffer out again
+            glBindVertexArray(0);
+            uploadMazeChunks(maze);
+            return;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, chunk.baseVertex * sizeof(MazeVertex),
+                        verts.size() * sizeof(MazeVertex), verts.data());
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, chunk.firstIndex * sizeof(uint16_t),
+                        indices.size() * sizeof(uint16_t), indices.data());
+        chunk.indexCount = (int)indices.size();
+    }
+    glBindVertexArray(0);
 }
 
-void Renderer::generateWallTexture() {
-    glGenTextures(1, &wallTextureID);
-    glBindTexture(GL_TEXTURE_2D, wallTextureID);
+Renderer::TextureImage Renderer::generateWallTexture() {
+    TextureImage image;
 
     // Try loading an external texture from textures/wall.png
     int imgW, imgH, imgChannels;
-    unsigned char* data = stbi_load("textures/wall.png", &imgW, &imgH, &imgChannels, 3);
+    unsigned char* data = stbi_load("textures/wall.png", &imgW, &imgH, &imgChannels, 4);
     if (data) {
         std::cerr << "Loaded wall texture from textures/wall.png ("
                   << imgW << "x" << imgH << ")\n";
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, imgW, imgH, 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, data);
+        image = {imgW, imgH, std::vector<unsigned char>(data, data + imgW * imgH * 4)};
         stbi_image_free(data);
     } else {
         std::cerr << "textures/wall.png not found, using procedural texture\n";
 
-        // Fall back to procedural stone brick texture
+        // Fall back to procedural stone brick texture (opaque RGBA)
         const int TEX_SIZE = 128;
-        std::vector<unsigned char> pixels(TEX_SIZE * TEX_SIZE * 3);
+        std::vector<unsigned char> pixels(TEX_SIZE * TEX_SIZE * 4, 255);
 
         const int brickH = TEX_SIZE / 4;
         const int brickW = TEX_SIZE / 2;
@@ -336,7 +577,7 @@ void Renderer::generateWallTexture() {
 
                 bool isMortar = (inBrickX < mortarSize || inBrickY < mortarSize);
 
-                int idx = (y * TEX_SIZE + x) * 3;
+                int idx = (y * TEX_SIZE + x) * 4;
 
                 if (isMortar) {
                     pixels[idx + 0] = 60;
@@ -364,39 +605,27 @@ void Renderer::generateWallTexture() {
             }
         }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEX_SIZE, TEX_SIZE, 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        image = {TEX_SIZE, TEX_SIZE, std::move(pixels)};
     }
-
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    // Use nearest-neighbor filtering for pixelated Minecraft look
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return image;
 }
 
-void Renderer::generateGroundTexture() {
-    glGenTextures(1, &groundTextureID);
-    glBindTexture(GL_TEXTURE_2D, groundTextureID);
+Renderer::TextureImage Renderer::generateGroundTexture() {
+    TextureImage image;
 
     // Try loading an external texture from textures/ground.png
     int imgW, imgH, imgChannels;
-    unsigned char* data = stbi_load("textures/ground.png", &imgW, &imgH, &imgChannels, 3);
+    unsigned char* data = stbi_load("textures/ground.png", &imgW, &imgH, &imgChannels, 4);
     if (data) {
         std::cerr << "Loaded ground texture from textures/ground.png ("
                   << imgW << "x" << imgH << ")\n";
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, imgW, imgH, 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, data);
+        image = {imgW, imgH, std::vector<unsigned char>(data, data + imgW * imgH * 4)};
         stbi_image_free(data);
     } else {
         std::cerr << "textures/ground.png not found, using procedural texture\n";
 
         const int TEX_SIZE = 128;
-        std::vector<unsigned char> pixels(TEX_SIZE * TEX_SIZE * 3);
+        std::vector<unsigned char> pixels(TEX_SIZE * TEX_SIZE * 4, 255);
 
         for (int y = 0; y < TEX_SIZE; y++) {
             for (int x = 0; x < TEX_SIZE; x++) {
@@ -421,31 +650,20 @@ void Renderer::generateGroundTexture() {
                 base_g = base_g + noise + blade;
                 base_b = base_b + noise / 3;
 
-                int idx = (y * TEX_SIZE + x) * 3;
+                int idx = (y * TEX_SIZE + x) * 4;
                 pixels[idx + 0] = (unsigned char)(std::clamp(base_r, 0, 255));
                 pixels[idx + 1] = (unsigned char)(std::clamp(base_g, 0, 255));
                 pixels[idx + 2] = (unsigned char)(std::clamp(base_b, 0, 255));
             }
         }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, TEX_SIZE, TEX_SIZE, 0,
-                     GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+        image = {TEX_SIZE, TEX_SIZE, std::move(pixels)};
     }
-
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    // Use nearest-neighbor filtering for pixelated Minecraft look
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return image;
 }
 
-void Renderer::generateGiftBoxTexture() {
-    glGenTextures(1, &giftBoxTextureID);
-    glBindTexture(GL_TEXTURE_2D, giftBoxTextureID);
+Renderer::TextureImage Renderer::generateGiftBoxTexture() {
+    TextureImage image;
 
     // Try loading an external texture from textures/gift_box.png
     int imgW, imgH, imgChannels;
@@ -453,8 +671,7 @@ void Renderer::generateGiftBoxTexture() {
     if (data) {
         std::cerr << "Loaded gift box texture from textures/gift_box.png ("
                   << imgW << "x" << imgH << ")\n";
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, imgW, imgH, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, data);
+        image = {imgW, imgH, std::vector<unsigned char>(data, data + imgW * imgH * 4)};
         stbi_image_free(data);
     } else {
         std::cerr << "textures/gift_box.png not found, using procedural texture\n";
@@ -502,16 +719,9 @@ void Renderer::generateGiftBoxTexture() {
             }
         }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEX_SIZE, TEX_SIZE, 0,
-                     GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        image = {TEX_SIZE, TEX_SIZE, std::move(pixels)};
     }
-
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return image;
 }
 
 void Renderer::buildGiftBoxMesh() {
@@ -527,7 +737,9 @@ void Renderer::buildGiftBoxMesh() {
     glBindBuffer(GL_ARRAY_BUFFER, giftBoxVBO);
     glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
 
-    // Same vertex layout as maze mesh (11-float stride)
+    // Float layout pos(3) + color(3) + normal(3) + texcoord(2), 11-float
+    // stride, as built by addCubeTextured (the maze mesh uses packed 8-byte
+    // vertices instead)
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(3 * sizeof(float)));
@@ -537,34 +749,41 @@ void Renderer::buildGiftBoxMesh() {
     glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (void*)(9 * sizeof(float)));
     glEnableVertexAttribArray(3);
 
+    // Per-instance records (item_vertex.glsl); the pointer is set per draw,
+    // at this frame's offset in the stream
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
     glBindVertexArray(0);
 }
-void Renderer::generateGraffitiTextures() {
+
+// Stream itemInstances and draw them all with one instanced call (the
+// gift box VAO is bound)
+void Renderer::drawItemInstances() {
+    if (itemInstances.empty()) return;
+    GLintptr offset = stream->write(itemInstances.data(),
+                                    (GLsizeiptr)(itemInstances.size() * sizeof(ItemInstance)),
+                                    sizeof(ItemInstance));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(ItemInstance), (void*)offset);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, giftBoxVertexCount, (GLsizei)itemInstances.size());
+}
+std::vector<Renderer::TextureImage> Renderer::generateGraffitiTextures() {
+    std::vector<TextureImage> images;
+
     // Try loading external graffiti textures from textures/graffiti/
     for (const auto& filename : GRAFFITI_FILES) {
         std::string path = "textures/graffiti/" + filename;
         int imgW, imgH, imgChannels;
         unsigned char* data = stbi_load(path.c_str(), &imgW, &imgH, &imgChannels, 4);
         if (data) {
-            unsigned int texID;
-            glGenTextures(1, &texID);
-            glBindTexture(GL_TEXTURE_2D, texID);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, imgW, imgH, 0,
-                         GL_RGBA, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
-            graffitiTextureIDs.push_back(texID);
+            images.push_back({imgW, imgH, std::vector<unsigned char>(data, data + imgW * imgH * 4)});
             stbi_image_free(data);
             std::cerr << "Loaded graffiti: " << path << "\n";
         }
     }
 
     // If no external textures loaded, generate procedural graffiti
-    if (graffitiTextureIDs.empty()) {
+    if (images.empty()) {
         std::cerr << "No graffiti files found, generating procedural graffiti\n";
         const int TEX_SIZE = 64;
 
@@ -597,18 +816,7 @@ void Renderer::generateGraffitiTextures() {
                     }
                 }
             }
-            unsigned int texID;
-            glGenTextures(1, &texID);
-            glBindTexture(GL_TEXTURE_2D, texID);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEX_SIZE, TEX_SIZE, 0,
-                         GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-            glGenerateMipmap(GL_TEXTURE_2D);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
-            graffitiTextureIDs.push_back(texID);
+            images.push_back({TEX_SIZE, TEX_SIZE, std::move(pixels)});
         };
 
         // Pattern 1: Arrow pointing right (red)
@@ -671,26 +879,103 @@ void Renderer::generateGraffitiTextures() {
             return false;
         }, 0.1f, 0.7f, 0.1f);
     }
+    return images;
 }
 
-void Renderer::buildGraffitiMesh(const Maze& maze) {
-    if (graffitiTextureIDs.empty()) return;
+// Resample one image to size x size. Each destination texel covers a box of
+// source texels (at least one per axis); the box is averaged with colour
+// weighted by alpha, so transparent decal pixels don't darken the edges.
+void Renderer::resampleLayer(const TextureImage& image, int size, std::vector<unsigned char>& out) {
+    for (int y = 0; y < size; y++) {
+        int sy0 = y * image.height / size;
+        int sy1 = std::max(sy0 + 1, (y + 1) * image.height / size);
+        for (int x = 0; x < size; x++) {
+            int sx0 = x * image.width / size;
+            int sx1 = std::max(sx0 + 1, (x + 1) * image.width / size);
+            unsigned char* dst = &out[(y * size + x) * 4];
+            if (sy1 - sy0 == 1 && sx1 - sx0 == 1) {
+                std::copy_n(&image.rgba[(sy0 * image.width + sx0) * 4], 4, dst);
+                continue;
+            }
 
-    // We need separate draw calls per texture, but for simplicity we'll
-    // store per-vertex texture index in color channel and render all graffiti
-    // with the same texture in batches. For this implementation, we batch
-    // all graffiti into one VBO with texture index encoded, then render
-    // in passes per texture.
+            unsigned int r = 0, g = 0, b = 0, a = 0;
+            for (int sy = sy0; sy < sy1; sy++) {
+                const unsigned char* src = &image.rgba[(sy * image.width + sx0) * 4];
+                for (int sx = sx0; sx < sx1; sx++, src += 4) {
+                    r += src[0] * src[3];
+                    g += src[1] * src[3];
+                    b += src[2] * src[3];
+                    a += src[3];
+                }
+            }
 
-    // Actually, simpler: store all graffiti quads in one mesh and track
-    // which texture each set of 6 vertices uses. We'll render in passes.
+            unsigned int texels = (unsigned int)((sy1 - sy0) * (sx1 - sx0));
+            if (a > 0) {
+                dst[0] = (unsigned char)((r + a / 2) / a);
+                dst[1] = (unsigned char)((g + a / 2) / a);
+                dst[2] = (unsigned char)((b + a / 2) / a);
+            } else {
+                dst[0] = dst[1] = dst[2] = 0;
+            }
+            dst[3] = (unsigned char)((a + texels / 2) / texels);
+        }
+    }
+}
 
-    // Vertex format: pos(3) + normal(3) + texcoord(2) = 8 floats
-    struct GraffitiBatch {
-        std::vector<float> verts;
-    };
+// Pack every material and decal image into one texture array. Layers must
+// share a size: smaller images are scaled up nearest-neighbour to keep their
+// blocky texels, larger ones are area-averaged down so decals don't alias.
+void Renderer::buildMaterialArray() {
+    std::vector<TextureImage> layers;
+    layers.push_back(generateWallTexture());      // LAYER_WALL
+    layers.push_back(generateGroundTexture());    // LAYER_GROUND
+    layers.push_back(generateGiftBoxTexture());   // LAYER_GIFT_BOX
+    std::vector<TextureImage> graffiti = generateGraffitiTextures();
+    graffitiLayerCount = (int)graffiti.size();
+    for (auto& image : graffiti) layers.push_back(std::move(image));
+
+    int size = 1;
+    for (const auto& image : layers) size = std::max({size, image.width, image.height});
+    size = std::min(size, MAX_LAYER_SIZE);
+    materialLayerSize = size;
+
+    glGenTextures(1, &materialArrayID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, materialArrayID);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, (GLsizei)layers.size(), 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    std::vector<unsigned char> resampled(size * size * 4);
+    for (int layer = 0; layer < (int)layers.size(); layer++) {
+        const TextureImage& image = layers[layer];
+        const unsigned char* pixels = image.rgba.data();
+        if (image.width != size || image.height != size) {
+            resampleLayer(image, size, resampled);
+            pixels = resampled.data();
+        }
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, size, size, 1,
+                        GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
 
-    std::vector<GraffitiBatch> batches(graffitiTextureIDs.size());
+    // Use nearest-neighbor filtering for pixelated Minecraft look. Walls and
+    // floors tile, so every layer repeats; decals keep their UVs inside [0,1].
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void Renderer::buildGraffitiMesh(const Maze& maze) {
+    if (graffitiLayerCount == 0) return;
+
+    // All decals share one stream whatever their texture: the layer of the
+    // material array rides along with every vertex.
+    // Vertex format: pos(3) + normal(3) + texcoord(2) + layer(1) = 9 floats
+    std::vector<float> verts;
+    graffitiDecalCells.clear();
 
     int w = maze.getWidth();
     int h = maze.getHeight();
@@ -705,7 +990,8 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
 
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
-            if (!maze.isWall(x, y)) continue;
+            // Only static stone walls carry graffiti; doors and gates move
+            if (maze.getCell(x, y) != CellType::WALL) continue;
 
             float wx = x * CELL_SIZE;
             float wz = y * CELL_SIZE;
@@ -748,7 +1034,7 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
                 // Check if adjacent cell is a path (not wall and in bounds)
                 if (face.adjX < 0 || face.adjX >= w || face.adjY < 0 || face.adjY >= h)
                     continue;
-                if (maze.isWall(face.adjX, face.adjY))
+                if (maze.getCell(face.adjX, face.adjY) == CellType::WALL)
                     continue;
 
                 // Decide if this face gets graffiti
@@ -757,7 +1043,8 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
                 if (randomValue > GRAFFITI_CHANCE) continue;
 
                 // Select graffiti texture
-                int texIdx = (int)(rh / 1000 % graffitiTextureIDs.size());
+                int texIdx = (int)(rh / 1000 % graffitiLayerCount);
+                float layer = (float)(LAYER_GRAFFITI + texIdx);
 
                 // Random scale (0.5x to 1.5x of wall height, clamped to wall)
                 unsigned int rh2 = hashCell(x + 100, y + 200, f + 300);
@@ -783,14 +1070,16 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
                 float oX = face.nx * offsetDist;
                 float oZ = face.nz * offsetDist;
 
-                // UV rotation: sometimes flip 180
+                // UV rotation: sometimes flip 180. Array layers repeat, so
+                // stay half a texel inside the edge instead of clamping.
+                float inset = 0.5f / (float)materialLayerSize;
                 bool flipUV = ((rh2 / 1000000) % 2 == 1);
-                float u0 = flipUV ? 1.0f : 0.0f;
-                float u1 = flipUV ? 0.0f : 1.0f;
-                float v0 = 0.0f, v1 = 1.0f;
+                float u0 = flipUV ? 1.0f - inset : inset;
+                float u1 = flipUV ? inset : 1.0f - inset;
+                float v0 = inset, v1 = 1.0f - inset;
 
                 // Build the graffiti quad
-                auto& batch = batches[texIdx];
+                graffitiDecalCells.push_back({face.adjX, face.adjY});
 
                 if (face.nz != 0) {
                     // Face on Z plane - graffiti extends in X and Y
@@ -800,13 +1089,13 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
                     float pz = cZ + oZ;
 
                     // Triangle 1
-                    batch.verts.insert(batch.verts.end(), {px - hw, cY - hh, pz, face.nx, face.ny, face.nz, u0, v0});
-                    batch.verts.insert(batch.verts.end(), {px + hw, cY - hh, pz, face.nx, face.ny, face.nz, u1, v0});
-                    batch.verts.insert(batch.verts.end(), {px + hw, cY + hh, pz, face.nx, face.ny, face.nz, u1, v1});
+                    verts.insert(verts.end(), {px - hw, cY - hh, pz, face.nx, face.ny, face.nz, u0, v0, layer});
+                    verts.insert(verts.end(), {px + hw, cY - hh, pz, face.nx, face.ny, face.nz, u1, v0, layer});
+                    verts.insert(verts.end(), {px + hw, cY + hh, pz, face.nx, face.ny, face.nz, u1, v1, layer});
                     // Triangle 2
-                    batch.verts.insert(batch.verts.end(), {px - hw, cY - hh, pz, face.nx, face.ny, face.nz, u0, v0});
-                    batch.verts.insert(batch.verts.end(), {px + hw, cY + hh, pz, face.nx, face.ny, face.nz, u1, v1});
-                    batch.verts.insert(batch.verts.end(), {px - hw, cY + hh, pz, face.nx, face.ny, face.nz, u0, v1});
+                    verts.insert(verts.end(), {px - hw, cY - hh, pz, face.nx, face.ny, face.nz, u0, v0, layer});
+                    verts.insert(verts.end(), {px + hw, cY + hh, pz, face.nx, face.ny, face.nz, u1, v1, layer});
+                    verts.insert(verts.end(), {px - hw, cY + hh, pz, face.nx, face.ny, face.nz, u0, v1, layer});
                 } else {
                     // Face on X plane - graffiti extends in Z and Y
                     float hw = grafW * 0.5f;
@@ -815,54 +1104,19 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
                     float pz = cZ + offW + oZ;
 
                     // Triangle 1
-                    batch.verts.insert(batch.verts.end(), {px, cY - hh, pz - hw, face.nx, face.ny, face.nz, u0, v0});
-                    batch.verts.insert(batch.verts.end(), {px, cY - hh, pz + hw, face.nx, face.ny, face.nz, u1, v0});
-                    batch.verts.insert(batch.verts.end(), {px, cY + hh, pz + hw, face.nx, face.ny, face.nz, u1, v1});
+                    verts.insert(verts.end(), {px, cY - hh, pz - hw, face.nx, face.ny, face.nz, u0, v0, layer});
+                    verts.insert(verts.end(), {px, cY - hh, pz + hw, face.nx, face.ny, face.nz, u1, v0, layer});
+                    verts.insert(verts.end(), {px, cY + hh, pz + hw, face.nx, face.ny, face.nz, u1, v1, layer});
                     // Triangle 2
-                    batch.verts.insert(batch.verts.end(), {px, cY - hh, pz - hw, face.nx, face.ny, face.nz, u0, v0});
-                    batch.verts.insert(batch.verts.end(), {px, cY + hh, pz + hw, face.nx, face.ny, face.nz, u1, v1});
-                    batch.verts.insert(batch.verts.end(), {px, cY + hh, pz - hw, face.nx, face.ny, face.nz, u0, v1});
+                    verts.insert(verts.end(), {px, cY - hh, pz - hw, face.nx, face.ny, face.nz, u0, v0, layer});
+                    verts.insert(verts.end(), {px, cY + hh, pz + hw, face.nx, face.ny, face.nz, u1, v1, layer});
+                    verts.insert(verts.end(), {px, cY + hh, pz - hw, face.nx, face.ny, face.nz, u0, v1, layer});
                 }
             }
         }
     }
 
-    // Merge all batches into a single VBO with batch offsets
-    // For simplicity, we store graffiti batch info and render in passes
-    // But first, let's use a simpler approach: interleave texture index info
-    // Since OpenGL doesn't support per-vertex texture binding, we render in passes
-
-    // Store batch start/count for rendering
-    std::vector<float> allVerts;
-    // We'll track batch boundaries using graffitiVertexCount as total
-    // and store batch info in a member. For minimal changes, let's just
-    // flatten and use the first texture for all graffiti, OR render per-batch.
-
-    // Actually the cleanest approach: store each batch separately in the VBO
-    // and record offsets. We'll store them sequentially.
-
-    // We need a helper struct. For minimal additions, store counts per batch.
-    // Let's use a simple approach: total verts, render all with same settings.
-
-    // Store batch info as a concatenated buffer with known offsets
-    struct BatchInfo {
-        int startVertex;
-        int vertexCount;
-        int textureIdx;
-    };
-    std::vector<BatchInfo> batchInfos;
-
-    for (size_t i = 0; i < batches.size(); i++) {
-        if (batches[i].verts.empty()) continue;
-        BatchInfo bi;
-        bi.startVertex = (int)(allVerts.size() / 8);
-        bi.vertexCount = (int)(batches[i].verts.size() / 8);
-        bi.textureIdx = (int)i;
-        batchInfos.push_back(bi);
-        allVerts.insert(allVerts.end(), batches[i].verts.begin(), batches[i].verts.end());
-    }
-
-    graffitiVertexCount = (int)(allVerts.size() / 8);
+    graffitiVertexCount = (int)(verts.size() / 9);
 
     if (graffitiVertexCount == 0) return;
 
@@ -872,106 +1126,144 @@ void Renderer::buildGraffitiMesh(const Maze& maze) {
     glGenBuffers(1, &graffitiVBO);
     glBindVertexArray(graffitiVAO);
     glBindBuffer(GL_ARRAY_BUFFER, graffitiVBO);
-    glBufferData(GL_ARRAY_BUFFER, allVerts.size() * sizeof(float), allVerts.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
 
-    // Stride: 8 floats (pos3 + normal3 + uv2)
+    // Stride: 9 floats (pos3 + normal3 + uv2 + layer1)
     // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     // Normal (reuse color slot for shading)
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(2);
     // TexCoord
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
     glEnableVertexAttribArray(3);
+    // Texture array layer
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(4);
 
     glBindVertexArray(0);
-
-    // Store batch rendering info
-    graffitiBatchInfos_.clear();
-    for (auto& bi : batchInfos) {
-        GraffitiBatchInfo gbi;
-        gbi.startVertex = bi.startVertex;
-        gbi.vertexCount = bi.vertexCount;
-        gbi.textureIdx = bi.textureIdx;
-        graffitiBatchInfos_.push_back(gbi);
-    }
 }
-static void setLightingUniforms(Shader& shader,
-                                const glm::vec3& sunDir, const glm::vec3& sunColor,
-                                float ambientLevel, const glm::vec3& fogCol,
-                                bool torchEnabled, const glm::vec3& torchPos,
-                                const glm::vec3& torchColor, float torchRadius) {
-    shader.setVec3("lightDir", sunDir);
-    shader.setVec3("fogColor", fogCol);
-    shader.setFloat("fogDensity", 0.035f);
-    shader.setFloat("fogGradient", 2.0f);
-    shader.setVec3("sunColor", sunColor);
-    shader.setFloat("ambientLevel", ambientLevel);
-    shader.setBool("torchEnabled", torchEnabled);
-    shader.setVec3("torchPos", torchPos);
-    shader.setVec3("torchColor", torchColor);
-    shader.setFloat("torchRadius", torchRadius);
-    shader.setBool("enableEdgeOutline", true);
+
+unsigned Renderer::litFeatures() const {
+    return torchLit ? ShaderVariants::TORCH : 0u;
 }
 
-void Renderer::renderMaze(Shader& shader, const glm::mat4& view, const glm::mat4& projection,
-                           const glm::vec3& sunDir, const glm::vec3& sunColor,
-                           float ambientLevel, const glm::vec3& fogCol,
-                           bool torchEnabled, const glm::vec3& torchPos,
-                           const glm::vec3& torchColor, float torchRadius) {
-    shader.use();
-    glm::mat4 model = glm::mat4(1.0f);
-    shader.setMat4("model", model);
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-
-    setLightingUniforms(shader, sunDir, sunColor, ambientLevel, fogCol,
-                        torchEnabled, torchPos, torchColor, torchRadius);
-
-    // Draw ground with dedicated texture
-    shader.setBool("useTexture", true);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, groundTextureID);
-    shader.setInt("wallTexture", 0);
-
-    if (groundVAO && groundVertexCount > 0) {
-        glBindVertexArray(groundVAO);
-        glDrawArrays(GL_TRIANGLES, 0, groundVertexCount);
-        glBindVertexArray(0);
+void Renderer::renderMaze(RenderQueue& queue, ShaderVariants& mazeShaders,
+                          ShaderVariants& gridShaders, ShaderVariants& shaders,
+                          const glm::mat4& view, const glm::mat4& projection) {
+    glm::mat3 rotation(view);
+    glm::vec3 cameraPos = -(glm::transpose(rotation) * glm::vec3(view[3]));
+
+    if (mazeRenderMode == MazeRenderMode::GRID) {
+        // Vertex pulling from the grid texture: one instance per cell
+        RenderQueue::Draw draw;
+        draw.shader = &gridShaders.get(ShaderVariants::TEXTURE |
+                                       ShaderVariants::EDGE_OUTLINE | litFeatures());
+        draw.vao = gridVAO;
+        draw.texture = materialArrayID;
+        draw.position = cameraPos;
+        draw.owner = this;
+        draw.draw = [](const RenderQueue::Draw& d, Shader& gridShader, GLStateCache& state) {
+            const Renderer& self = *static_cast<const Renderer*>(d.owner);
+            gridShader.setFloat("cullDistance", MAZE_CULL_DISTANCE);
+            gridShader.setIVec2("gridSize", self.gridWidth, self.gridHeight);
+            state.bindTexture(1, GL_TEXTURE_2D, self.gridTextureID);
+            gridShader.setInt("mazeGrid", 1);
+            gridShader.setInt("materialTextures", 0);
+            // Floor, ceiling and four wall faces per cell in one draw
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6 * 6, self.gridWidth * self.gridHeight);
+        };
+        queue.submit(draw);
+    } else {
+        // Packed, indexed chunk meshes (maze geometry is already in world space)
+        Shader& mazeShader = mazeShaders.get(ShaderVariants::TEXTURE |
+                                             ShaderVariants::EDGE_OUTLINE | litFeatures());
+
+        // Cull chunks outside the frustum or lost in fog, then sort the rest
+        // front-to-back so early depth testing rejects hidden fragments
+        Frustum frustum(projection * view);
+        visibleChunks.clear();
+        for (int i = 0; i < (int)mazeChunks.size(); i++) {
+            const MazeChunk& chunk = mazeChunks[i];
+            glm::vec3 nearest = glm::clamp(cameraPos, chunk.boundsMin, chunk.boundsMax);
+            float dist = glm::length(nearest - cameraPos);
+            if (dist > MAZE_CULL_DISTANCE) continue;
+            if (visibilityValid && !chunkHasVisibleCell[i]) continue;
+            if (!frustum.intersectsBox(chunk.boundsMin, chunk.boundsMax)) continue;
+            visibleChunks.push_back({dist, i});
+        }
+        std::sort(visibleChunks.begin(), visibleChunks.end());
+
+        // Floors, walls and ceilings all sample the material array, so every
+        // visible chunk goes out in one multi-draw (still front-to-back)
+        chunkDrawCounts.clear();
+        chunkDrawOffsets.clear();
+        chunkDrawBaseVertices.clear();
+        for (auto& visible : visibleChunks) {
+            const MazeChunk& chunk = mazeChunks[visible.second];
+            if (chunk.indexCount == 0) continue;
+            chunkDrawCounts.push_back(chunk.indexCount);
+            chunkDrawOffsets.push_back((const void*)(chunk.firstIndex * sizeof(uint16_t)));
+            chunkDrawBaseVertices.push_back(chunk.baseVertex);
+        }
+        if (!chunkDrawCounts.empty()) {
+            // The arrays are members, so they stay put until the queue flushes
+            RenderQueue::Draw draw;
+            draw.shader = &mazeShader;
+            draw.vao = mazeVAO;
+            draw.texture = materialArrayID;
+            draw.position = cameraPos;
+            draw.owner = this;
+            draw.draw = [](const RenderQueue::Draw& d, Shader& shader, GLStateCache&) {
+                const Renderer& self = *static_cast<const Renderer*>(d.owner);
+                shader.setInt("materialTextures", 0);
+                glMultiDrawElementsBaseVertex(GL_TRIANGLES, self.chunkDrawCounts.data(),
+                                              GL_UNSIGNED_SHORT, self.chunkDrawOffsets.data(),
+                                              (GLsizei)self.chunkDrawCounts.size(),
+                                              self.chunkDrawBaseVertices.data());
+            };
+            queue.submit(draw);
+        }
     }
 
-    // Bind wall texture for walls/ceilings
-    glBindTexture(GL_TEXTURE_2D, wallTextureID);
-
-    glBindVertexArray(mazeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, mazeVertexCount);
-    glBindVertexArray(0);
-
-    // Render graffiti decals
-    if (graffitiVAO && !graffitiBatchInfos_.empty()) {
-        shader.setBool("useTexture", true);
-        shader.setBool("enableEdgeOutline", false);
-        // Set vertex color to white so texture shows through properly
-        // The graffiti VAO has no color attribute, so we set a default
-        glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDepthMask(GL_FALSE); // don't write to depth for decals
-
-        glBindVertexArray(graffitiVAO);
-        for (auto& bi : graffitiBatchInfos_) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, graffitiTextureIDs[bi.textureIdx]);
-            shader.setInt("wallTexture", 0);
-            glDrawArrays(GL_TRIANGLES, bi.startVertex, bi.vertexCount);
+    // Graffiti decals, the only alpha-tested draw; blended without depth
+    // writes in the decal pass
+    if (graffitiVAO && graffitiVertexCount > 0) {
+        // One multi-draw over the decals facing visible cells, merging
+        // neighbouring decals into one range; each vertex carries its layer
+        graffitiFirsts.clear();
+        graffitiCounts.clear();
+        for (int v = 0; v < graffitiVertexCount; v += 6) {
+            auto [cx, cy] = graffitiDecalCells[v / 6];
+            if (visibilityValid && !visibility.isCellVisible(cx, cy)) continue;
+            if (!graffitiFirsts.empty() && graffitiFirsts.back() + graffitiCounts.back() == v)
+                graffitiCounts.back() += 6;
+            else {
+                graffitiFirsts.push_back(v);
+                graffitiCounts.push_back(6);
+            }
+        }
+        if (!graffitiFirsts.empty()) {
+            RenderQueue::Draw draw;
+            draw.pass = RenderQueue::PASS_DECAL;
+            draw.shader = &shaders.get(ShaderVariants::TEXTURE | ShaderVariants::ALPHA_TEST |
+                                       ShaderVariants::STATIC | litFeatures());
+            draw.vao = graffitiVAO;
+            draw.texture = materialArrayID;
+            draw.position = cameraPos;
+            draw.owner = this;
+            draw.draw = [](const RenderQueue::Draw& d, Shader& shader, GLStateCache&) {
+                const Renderer& self = *static_cast<const Renderer*>(d.owner);
+                // Set vertex color to white so texture shows through properly
+                // The graffiti VAO has no color attribute, so we set a default
+                glVertexAttrib3f(1, 1.0f, 1.0f, 1.0f);
+                shader.setInt("materialTextures", 0);
+                glMultiDrawArrays(GL_TRIANGLES, self.graffitiFirsts.data(),
+                                  self.graffitiCounts.data(), (GLsizei)self.graffitiFirsts.size());
+            };
+            queue.submit(draw);
         }
-        glBindVertexArray(0);
-
-        glDepthMask(GL_TRUE);
-        glDisable(GL_BLEND);
-        shader.setBool("enableEdgeOutline", true);
     }
 }
 
@@ -994,6 +1286,173 @@ void Renderer::buildCubeMesh() {
     glBindVertexArray(0);
 }
 
+void Renderer::buildEnemyMesh() {
+    std::vector<float> verts;
+    // Body: tall maroon block standing on the floor, facing +Z
+    addCube(verts, -0.4f, 0.0f, -0.4f, 0.8f, 1.5f, 0.8f, 0.45f, 0.08f, 0.12f);
+    // Glowing eyes on the front face
+    addCube(verts, -0.28f, 1.05f, 0.4f, 0.2f, 0.14f, 0.05f, 1.0f, 0.85f, 0.2f);
+    addCube(verts,  0.08f, 1.05f, 0.4f, 0.2f, 0.14f, 0.05f, 1.0f, 0.85f, 0.2f);
+    enemyVertexCount = (int)(verts.size() / 9);
+
+    glGenVertexArrays(1, &enemyVAO);
+    glGenBuffers(1, &enemyVBO);
+    glBindVertexArray(enemyVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, enemyVBO);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)(3*sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)(6*sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    // Per-instance records (enemy_vertex.glsl); the pointer is set per draw,
+    // at this frame's offset in the stream
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+}
+
+// Stream enemyInstances and draw them all with one instanced call (the
+// enemy VAO is bound)
+void Renderer::drawEnemyInstances() {
+    if (enemyInstances.empty()) return;
+    GLintptr offset = stream->write(enemyInstances.data(),
+                                    (GLsizeiptr)(enemyInstances.size() * sizeof(EnemyInstance)),
+                                    sizeof(EnemyInstance));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(EnemyInstance), (void*)offset);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, enemyVertexCount, (GLsizei)enemyInstances.size());
+}
+
+// Exit gateway animation kinds (must match exit_vertex.glsl)
+static const float EXIT_MOTION_STATIC = 0.0f;
+static const float EXIT_MOTION_BEACON = 1.0f;   // bobs up and down
+static const float EXIT_MOTION_SPARK  = 2.0f;   // orbits the beacon
+
+void Renderer::buildExitZoneMesh() {
+    std::vector<ExitInstance> blocks;
+    const glm::vec4 steady(1.0f, 0.0f, 0.0f, 0.0f);
+    const glm::vec2 fixed(EXIT_MOTION_STATIC, 0.0f);
+
+    // Blocks keep the placement of the old per-cube draws: addCube() built
+    // each one from (-0.5, -0.5, -0.5) out to scale, so a block spans
+    // pos - 0.5 to pos - 0.5 + scale and its centre sits at
+    // pos - 0.5 + scale / 2. For the animated beacon and sparks pos is the
+    // position the shader computes, and the same offset is added there.
+    auto addBlock = [&](glm::vec3 pos, glm::vec3 scale, glm::vec3 color,
+                        glm::vec4 pulse, glm::vec2 motion) {
+        blocks.push_back({pos - 0.5f + scale * 0.5f, scale, color, pulse, motion});
+    };
+
+    // --- Exit Zone: Gateway to Infinite Outside World ---
+
+    // Large platform representing the transition area
+    float platformSize = 6.0f;  // Larger platform (6x6 units = 3 cells)
+    addBlock(glm::vec3(0.0f, 0.05f, 0.0f), glm::vec3(platformSize, 0.1f, platformSize),
+             glm::vec3(0.8f, 0.85f, 0.9f), steady, fixed);  // Light, almost white stone
+
+    // Create a visual boundary arch/gateway
+    // Two large pillars on either side
+    float archHeight = 5.0f;
+    float archWidth = 0.4f;
+    float archSpacing = 3.5f;
+    glm::vec3 archColor(0.6f, 0.65f, 0.7f);
+    for (float side : {-archSpacing, archSpacing})
+        addBlock(glm::vec3(side, archHeight * 0.5f, 0.0f),
+                 glm::vec3(archWidth, archHeight, archWidth), archColor, steady, fixed);
+
+    // Archway top (lintel)
+    addBlock(glm::vec3(0.0f, archHeight, 0.0f),
+             glm::vec3(archSpacing * 2.0f + archWidth, archWidth, archWidth),
+             archColor, steady, fixed);
+
+    // Glowing energy curtain representing the exit portal
+    addBlock(glm::vec3(0.0f, archHeight * 0.5f, 0.0f),
+             glm::vec3(archSpacing * 2.0f - archWidth, archHeight * 0.9f, 0.1f),
+             glm::vec3(0.5f, 0.8f, 1.0f), glm::vec4(0.3f, 0.2f, 1.5f, 0.0f), fixed);
+
+    // Four corner markers showing the boundary of the exit zone, each with
+    // a pulsing light at the top
+    float markerH = 1.5f;
+    float markerW = 0.2f;
+    float markerOff = platformSize * 0.45f;
+    for (float px : {-markerOff, markerOff}) {
+        for (float pz : {-markerOff, markerOff}) {
+            addBlock(glm::vec3(px, markerH * 0.5f, pz), glm::vec3(markerW, markerH, markerW),
+                     glm::vec3(0.5f, 0.55f, 0.6f), steady, fixed);
+            addBlock(glm::vec3(px, markerH + 0.15f, pz),
+                     glm::vec3(markerW * 2.0f, 0.15f, markerW * 2.0f),
+                     glm::vec3(0.3f, 0.9f, 1.0f), glm::vec4(0.5f, 0.5f, 2.0f, px + pz), fixed);
+        }
+    }
+
+    // Central floating beacon
+    addBlock(glm::vec3(0.0f), glm::vec3(0.4f), glm::vec3(0.4f, 0.9f, 1.0f),
+             glm::vec4(0.6f, 0.4f, 2.5f, 0.0f), glm::vec2(EXIT_MOTION_BEACON, 0.0f));
+
+    // Orbiting particles around the beacon (representing freedom/escape)
+    for (int i = 0; i < 6; i++)
+        addBlock(glm::vec3(0.0f), glm::vec3(0.1f), glm::vec3(0.3f, 0.8f, 1.0f),
+                 glm::vec4(0.5f, 0.5f, 4.0f, (float)i),
+                 glm::vec2(EXIT_MOTION_SPARK, (float)i));
+
+    // Add ground-level light rings expanding outward (representing the infinite world)
+    for (int ring = 0; ring < 3; ring++) {
+        float ringRadius = 2.5f + ring * 1.5f;
+        int segments = 12;
+        for (int seg = 0; seg < segments; seg++) {
+            float angle = (seg / (float)segments) * 6.283f;
+            addBlock(glm::vec3(ringRadius * std::cos(angle), 0.2f, ringRadius * std::sin(angle)),
+                     glm::vec3(0.15f, 0.1f, 0.15f), glm::vec3(0.4f, 0.7f, 0.9f),
+                     glm::vec4(0.5f, 0.5f, 2.0f, -0.5f * ring), fixed);
+        }
+    }
+    exitInstanceCount = (int)blocks.size();
+
+    // XZ footprint for visibility: every block's box, with the animated
+    // beacon and sparks widened by how far the shader can move them
+    const float SPARK_RADIUS = 0.7f;    // exit_vertex.glsl
+    exitBoundsMin = glm::vec2(0.0f);
+    exitBoundsMax = glm::vec2(0.0f);
+    for (const ExitInstance& block : blocks) {
+        float reach = block.motion.x == EXIT_MOTION_SPARK ? SPARK_RADIUS : 0.0f;
+        glm::vec2 centre(block.centre.x, block.centre.z);
+        glm::vec2 half = glm::vec2(block.scale.x, block.scale.z) * 0.5f + reach;
+        exitBoundsMin = glm::min(exitBoundsMin, centre - half);
+        exitBoundsMax = glm::max(exitBoundsMax, centre + half);
+    }
+
+    // Unit cube positions and normals from cubeVBO, one record per block
+    glGenVertexArrays(1, &exitVAO);
+    glBindVertexArray(exitVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    glGenBuffers(1, &exitInstanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, exitInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, blocks.size() * sizeof(ExitInstance), blocks.data(), GL_STATIC_DRAW);
+    const struct { GLuint location; GLint size; size_t offset; } fields[] = {
+        {5, 3, offsetof(ExitInstance, centre)},
+        {6, 3, offsetof(ExitInstance, scale)},
+        {7, 3, offsetof(ExitInstance, color)},
+        {8, 4, offsetof(ExitInstance, pulse)},
+        {9, 2, offsetof(ExitInstance, motion)},
+    };
+    for (const auto& f : fields) {
+        glVertexAttribPointer(f.location, f.size, GL_FLOAT, GL_FALSE, sizeof(ExitInstance),
+                              (void*)f.offset);
+        glEnableVertexAttribArray(f.location);
+        glVertexAttribDivisor(f.location, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
 void Renderer::buildPyramidMesh() {
     std::vector<float> verts;
     // Base quad
@@ -1085,211 +1544,85 @@ void Renderer::buildSphereMesh() {
     glBindVertexArray(0);
 }
 
-void Renderer::renderCollectibles(Shader& shader, const glm::mat4& view,
-                                  const glm::mat4& projection,
-                                  const std::vector<CollectibleItem>& items,
-                                  const glm::vec3& sunDir, const glm::vec3& sunColor,
-                                  float ambientLevel, const glm::vec3& fogCol,
-                                  bool torchEnabled, const glm::vec3& torchPos,
-                                  const glm::vec3& torchColor, float torchRadius) {
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    setLightingUniforms(shader, sunDir, sunColor, ambientLevel, fogCol,
-                        torchEnabled, torchPos, torchColor, torchRadius);
+void Renderer::renderCollectibles(RenderQueue& queue, ShaderVariants& itemShaders,
+                                  const Collectible& collectibles) {
+    // Gather boxes still in the world and not hidden behind walls; each gets
+    // its own spin phase (golden-angle steps by index) so neighbours don't
+    // turn and bob in lockstep
+    itemInstances.clear();
+    for (int i = 0; i < collectibles.getTotalCount(); i++) {
+        if (!collectibles.isInWorld(i)) continue;
+        glm::vec3 pos = collectibles.getPosition(i);
+        if (visibilityValid && !visibility.isPositionVisible(pos)) continue;
+        itemInstances.push_back({pos, std::fmod(i * 137.5f, 360.0f)});
+    }
+    if (itemInstances.empty()) return;
 
     // All collectables use the gift box texture and rectangular mesh
-    shader.setBool("useTexture", true);
-    shader.setBool("enableEdgeOutline", false);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, giftBoxTextureID);
-    shader.setInt("wallTexture", 0);
-
-    for (auto& item : items) {
-        // Skip collected or picked-up items (no longer in the world)
-        if (item.collected || item.pickedUp) continue;
-
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), item.position);
-        model = glm::rotate(model, glm::radians(item.rotationAngle), glm::vec3(0, 1, 0));
-
-        float bob = sin(item.rotationAngle * 0.03f) * 0.15f;
-        model = glm::translate(model, glm::vec3(0, bob, 0));
-        model = glm::scale(model, glm::vec3(COLLECTIBLE_SIZE));
-
-        shader.setMat4("model", model);
-
-        // Render as textured gift box (axis-aligned rectangle/box)
-        glBindVertexArray(giftBoxVAO);
-        glDrawArrays(GL_TRIANGLES, 0, giftBoxVertexCount);
-        glBindVertexArray(0);
-    }
+    RenderQueue::Draw draw;
+    draw.shader = &itemShaders.get(ShaderVariants::TEXTURE | litFeatures());
+    draw.vao = giftBoxVAO;
+    draw.texture = materialArrayID;
+    draw.position = itemInstances.front().position;
+    draw.owner = this;
+    draw.params.x = collectibles.getRotation();
+    draw.draw = [](const RenderQueue::Draw& d, Shader& itemShader, GLStateCache&) {
+        itemShader.setFloat("spinAngle", d.params.x);
+        itemShader.setFloat("itemSize", COLLECTIBLE_SIZE);
+        itemShader.setInt("materialTextures", 0);
+        static_cast<Renderer*>(d.owner)->drawItemInstances();
+    };
+    queue.submit(draw);
 }
 
-void Renderer::renderCarriedCollectible(Shader& shader, const glm::mat4& view,
-                                        const glm::mat4& projection,
-                                        const glm::vec3& playerPos,
-                                        const glm::vec3& playerFront,
-                                        int carryCount,
-                                        const glm::vec3& sunDir, const glm::vec3& sunColor,
-                                        float ambientLevel, const glm::vec3& fogCol,
-                                        bool torchEnabled, const glm::vec3& torchPos,
-                                        const glm::vec3& torchColor, float torchRadius) {
-    if (carryCount <= 0) return;
-
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    setLightingUniforms(shader, sunDir, sunColor, ambientLevel, fogCol,
-                        torchEnabled, torchPos, torchColor, torchRadius);
-
-    // Use gift box texture
-    shader.setBool("useTexture", true);
-    shader.setBool("enableEdgeOutline", false);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, giftBoxTextureID);
-    shader.setInt("wallTexture", 0);
-
-    // Base position: slightly in front, to the right, below eye level
-    glm::vec3 flatFront = glm::normalize(glm::vec3(playerFront.x, 0.0f, playerFront.z));
-    glm::vec3 right = glm::normalize(glm::cross(flatFront, glm::vec3(0.0f, 1.0f, 0.0f)));
-    glm::vec3 basePos = playerPos
-                      + flatFront * CARRY_FORWARD_OFFSET
-                      + right * CARRY_RIGHT_OFFSET
-                      + glm::vec3(0.0f, CARRY_Y_OFFSET, 0.0f);
-
-    // Stack boxes vertically; each box is COLLECTIBLE_SIZE above the previous
-    for (int i = 0; i < carryCount; i++) {
-        glm::vec3 stackPos = basePos + glm::vec3(0.0f, i * COLLECTIBLE_SIZE, 0.0f);
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), stackPos);
-        model = glm::scale(model, glm::vec3(COLLECTIBLE_SIZE));
-        shader.setMat4("model", model);
-
-        glBindVertexArray(giftBoxVAO);
-        glDrawArrays(GL_TRIANGLES, 0, giftBoxVertexCount);
-        glBindVertexArray(0);
+void Renderer::renderEnemies(RenderQueue& queue, ShaderVariants& enemyShaders, const Enemies& enemies) {
+    // Gather enemies not hidden behind walls
+    enemyInstances.clear();
+    for (int i = 0; i < enemies.getCount(); i++) {
+        glm::vec3 pos = enemies.getPosition(i);
+        if (visibilityValid && !visibility.isPositionVisible(pos)) continue;
+        enemyInstances.push_back({pos, enemies.getHeading(i)});
     }
-}
-
-void Renderer::renderExitZone(Shader& shader, const glm::mat4& view,
-                              const glm::mat4& projection,
-                              const glm::vec3& exitPos, float time,
-                              const glm::vec3& sunDir, const glm::vec3& sunColor,
-                              float ambientLevel, const glm::vec3& fogCol,
-                              bool torchEnabled, const glm::vec3& torchPos,
-                              const glm::vec3& torchColor, float torchRadius) {
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    setLightingUniforms(shader, sunDir, sunColor, ambientLevel, fogCol,
-                        torchEnabled, torchPos, torchColor, torchRadius);
-    shader.setBool("useTexture", false);
-    shader.setBool("enableEdgeOutline", false);
-
-    // Helper: render a cube at given world position and scale with given color
-    auto drawCube = [&](glm::vec3 pos, glm::vec3 scale, float r, float g, float b) {
-        std::vector<float> v;
-        addCube(v, -0.5f, -0.5f, -0.5f, scale.x, scale.y, scale.z, r, g, b);
-        glBindVertexArray(scratchVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, scratchVBO);
-        glBufferData(GL_ARRAY_BUFFER, v.size() * sizeof(float), v.data(), GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)(3*sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9*sizeof(float), (void*)(6*sizeof(float)));
-        glEnableVertexAttribArray(2);
-
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), pos);
-        shader.setMat4("model", model);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(v.size() / 9));
-        glBindVertexArray(0);
+    if (enemyInstances.empty()) return;
+
+    RenderQueue::Draw draw;
+    draw.shader = &enemyShaders.get(litFeatures());
+    draw.vao = enemyVAO;
+    draw.position = enemyInstances.front().position;
+    draw.owner = this;
+    draw.draw = [](const RenderQueue::Draw& d, Shader&, GLStateCache&) {
+        static_cast<Renderer*>(d.owner)->drawEnemyInstances();
     };
+    queue.submit(draw);
+}
 
-    // --- Exit Zone: Gateway to Infinite Outside World ---
-
-    // Large platform representing the transition area
-    float platformSize = 6.0f;  // Larger platform (6x6 units = 3 cells)
-    drawCube(exitPos + glm::vec3(0.0f, 0.05f, 0.0f),
-             glm::vec3(platformSize, 0.1f, platformSize),
-             0.8f, 0.85f, 0.9f);  // Light, almost white stone
-
-    // Create a visual boundary arch/gateway
-    // Two large pillars on either side
-    float archHeight = 5.0f;
-    float archWidth = 0.4f;
-    float archSpacing = 3.5f;
-
-    // Left pillar
-    drawCube(exitPos + glm::vec3(-archSpacing, archHeight * 0.5f, 0.0f),
-             glm::vec3(archWidth, archHeight, archWidth),
-             0.6f, 0.65f, 0.7f);
-
-    // Right pillar
-    drawCube(exitPos + glm::vec3(archSpacing, archHeight * 0.5f, 0.0f),
-             glm::vec3(archWidth, archHeight, archWidth),
-             0.6f, 0.65f, 0.7f);
-
-    // Archway top (lintel)
-    drawCube(exitPos + glm::vec3(0.0f, archHeight, 0.0f),
-             glm::vec3(archSpacing * 2.0f + archWidth, archWidth, archWidth),
-             0.6f, 0.65f, 0.7f);
-
-    // Glowing energy curtain representing the exit portal
-    float curtainPulse = 0.3f + 0.2f * sin(time * 1.5f);
-    float curtainAlpha = 0.4f + 0.3f * sin(time * 2.0f);
-    drawCube(exitPos + glm::vec3(0.0f, archHeight * 0.5f, 0.0f),
-             glm::vec3(archSpacing * 2.0f - archWidth, archHeight * 0.9f, 0.1f),
-             0.5f * curtainPulse, 0.8f * curtainPulse, 1.0f * curtainPulse);
-
-    // Four corner markers showing the boundary of the exit zone
-    float markerH = 1.5f;
-    float markerW = 0.2f;
-    float markerOff = platformSize * 0.45f;
-    for (float px : {-markerOff, markerOff}) {
-        for (float pz : {-markerOff, markerOff}) {
-            // Marker pillar
-            drawCube(exitPos + glm::vec3(px, markerH * 0.5f, pz),
-                     glm::vec3(markerW, markerH, markerW),
-                     0.5f, 0.55f, 0.6f);
-
-            // Pulsing light at top
-            float glowPulse = 0.5f + 0.5f * sin(time * 2.0f + px + pz);
-            drawCube(exitPos + glm::vec3(px, markerH + 0.15f, pz),
-                     glm::vec3(markerW * 2.0f, 0.15f, markerW * 2.0f),
-                     0.3f * glowPulse, 0.9f * glowPulse, 1.0f * glowPulse);
-        }
-    }
-
-    // Central floating beacon
-    float floatHeight = 1.5f + sin(time * 1.5f) * 0.2f;
-    float centralGlow = 0.6f + 0.4f * sin(time * 2.5f);
-    drawCube(exitPos + glm::vec3(0.0f, floatHeight, 0.0f),
-             glm::vec3(0.4f, 0.4f, 0.4f),
-             0.4f * centralGlow, 0.9f * centralGlow, 1.0f * centralGlow);
-
-    // Orbiting particles around the beacon (representing freedom/escape)
-    for (int i = 0; i < 6; i++) {
-        float angle = time * 2.5f + i * (6.283f / 6.0f); // 60° apart
-        float radius = 0.7f;
-        float particleY = floatHeight + sin(time * 3.0f + i * 1.2f) * 0.15f;
-        glm::vec3 ppos = exitPos + glm::vec3(
-            radius * cos(angle), particleY, radius * sin(angle));
-        float intensity = 0.5f + 0.5f * sin(time * 4.0f + i);
-        drawCube(ppos, glm::vec3(0.1f),
-                 0.3f * intensity, 0.8f * intensity, 1.0f * intensity);
+void Renderer::renderExitZone(RenderQueue& queue, ShaderVariants& exitShaders,
+                              const glm::vec3& exitPos, float time) {
+    // Drawn if any cell under the gateway's footprint (rings included) is
+    // visible
+    if (visibilityValid) {
+        int x0 = (int)std::floor((exitPos.x + exitBoundsMin.x) / CELL_SIZE);
+        int x1 = (int)std::floor((exitPos.x + exitBoundsMax.x) / CELL_SIZE);
+        int y0 = (int)std::floor((exitPos.z + exitBoundsMin.y) / CELL_SIZE);
+        int y1 = (int)std::floor((exitPos.z + exitBoundsMax.y) / CELL_SIZE);
+        bool seen = false;
+        for (int y = y0; y <= y1 && !seen; y++)
+            for (int x = x0; x <= x1 && !seen; x++)
+                seen = visibility.isCellVisible(x, y);
+        if (!seen) return;
     }
 
-    // Add ground-level light rings expanding outward (representing the infinite world)
-    for (int ring = 0; ring < 3; ring++) {
-        float ringRadius = 2.5f + ring * 1.5f;
-        float ringPulse = sin(time * 2.0f - ring * 0.5f) * 0.5f + 0.5f;
-        int segments = 12;
-        for (int seg = 0; seg < segments; seg++) {
-            float angle = (seg / (float)segments) * 6.283f;
-            glm::vec3 ringPos = exitPos + glm::vec3(
-                ringRadius * cos(angle), 0.2f, ringRadius * sin(angle));
-            drawCube(ringPos, glm::vec3(0.15f, 0.1f, 0.15f),
-                     0.4f * ringPulse, 0.7f * ringPulse, 0.9f * ringPulse);
-        }
-    }
+    RenderQueue::Draw draw;
+    draw.shader = &exitShaders.get(litFeatures());
+    draw.vao = exitVAO;
+    draw.position = exitPos;
+    draw.owner = this;
+    draw.params = glm::vec4(exitPos, time);
+    draw.draw = [](const RenderQueue::Draw& d, Shader& shader, GLStateCache&) {
+        const Renderer& self = *static_cast<const Renderer*>(d.owner);
+        shader.setVec3("exitPos", glm::vec3(d.params));
+        shader.setFloat("time", d.params.w);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, self.cubeVertexCount, self.exitInstanceCount);
+    };
+    queue.submit(draw);
 }
@@ -1,63 +1,111 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "GridVisibility.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <utility>
 
 class Maze;
 class Shader;
-struct CollectibleItem;
+class ShaderVariants;
+class Collectible;
+class Enemies;
+class StreamBuffer;
+class RenderQueue;
+struct MazeVertex;
+
+// How maze walls reach the GPU: CPU-built chunk meshes, or vertex pulling
+// from a one-byte-per-cell grid texture with no mesh at all
+enum class MazeRenderMode {
+    MESH,
+    GRID
+};
 
 class Renderer {
 public:
     Renderer();
     ~Renderer();
 
-    void init();
+    // Per-frame item instances are written to stream
+    void init(StreamBuffer& stream);
     void buildMazeMesh(const Maze& maze);
-    void renderMaze(Shader& shader, const glm::mat4& view, const glm::mat4& projection,
-                    const glm::vec3& sunDir, const glm::vec3& sunColor,
-                    float ambientLevel, const glm::vec3& fogCol,
-                    bool torchEnabled, const glm::vec3& torchPos,
-                    const glm::vec3& torchColor, float torchRadius);
-    void renderCollectibles(Shader& shader, const glm::mat4& view,
-                            const glm::mat4& projection,
-                            const std::vector<CollectibleItem>& items,
-                            const glm::vec3& sunDir, const glm::vec3& sunColor,
-                            float ambientLevel, const glm::vec3& fogCol,
-                            bool torchEnabled, const glm::vec3& torchPos,
-                            const glm::vec3& torchColor, float torchRadius);
-
-    // Render the exit zone (open area at maze end)
-    void renderExitZone(Shader& shader, const glm::mat4& view,
-                        const glm::mat4& projection,
-                        const glm::vec3& exitPos, float time,
-                        const glm::vec3& sunDir, const glm::vec3& sunColor,
-                        float ambientLevel, const glm::vec3& fogCol,
-                        bool torchEnabled, const glm::vec3& torchPos,
-                        const glm::vec3& torchColor, float torchRadius);
-
-    // Render a stack of carried collectibles attached to the player
-    void renderCarriedCollectible(Shader& shader, const glm::mat4& view,
-                                  const glm::mat4& projection,
-                                  const glm::vec3& playerPos,
-                                  const glm::vec3& playerFront,
-                                  int carryCount,
-                                  const glm::vec3& sunDir, const glm::vec3& sunColor,
-                                  float ambientLevel, const glm::vec3& fogCol,
-                                  bool torchEnabled, const glm::vec3& torchPos,
-                                  const glm::vec3& torchColor, float torchRadius);
+    // Remesh only the chunks touched by changed cells (doors, gates)
+    void updateMazeCells(const Maze& maze, const std::vector<std::pair<int,int>>& cells);
+    // All render calls cull on the CPU and record their draws into the
+    // queue, which issues them at its next flush; they read camera, fog and
+    // lighting from the per-frame uniform blocks (FrameUniforms) the queue
+    // binds per pass. Each picks the shader variant it needs (opaque draws
+    // never get the alpha-tested one). Maze chunks use the packed maze
+    // shader (or the grid shader in GRID mode); graffiti decals use the
+    // main one. view and projection drive the culling.
+    void renderMaze(RenderQueue& queue, ShaderVariants& mazeShaders, ShaderVariants& gridShaders,
+                    ShaderVariants& shaders,
+                    const glm::mat4& view, const glm::mat4& projection);
+    // Gift boxes are drawn instanced with item_vertex.glsl
+    void renderCollectibles(RenderQueue& queue, ShaderVariants& itemShaders,
+                            const Collectible& collectibles);
+
+    // Render the exit zone (open area at maze end) with exit_vertex.glsl;
+    // the gateway mesh is static and time drives its animation on the GPU
+    void renderExitZone(RenderQueue& queue, ShaderVariants& exitShaders,
+                        const glm::vec3& exitPos, float time);
+
+    // Enemies are drawn instanced with enemy_vertex.glsl
+    void renderEnemies(RenderQueue& queue, ShaderVariants& enemyShaders, const Enemies& enemies);
+
+    // Recompute which maze cells the camera can see (call once per frame
+    // before rendering). Maze chunks, graffiti, collectibles, enemies and the
+    // exit zone are only drawn where they touch a visible cell.
+    void updateVisibility(const Maze& maze, const glm::vec3& eye, const glm::vec3& front,
+                          const glm::mat4& projection);
+    const GridVisibility& getVisibility() const { return visibility; }
+
+    // Switch maze rendering path; MESH rebuilds the chunk meshes, GRID frees them
+    void setMazeRenderMode(MazeRenderMode mode, const Maze& maze);
+    MazeRenderMode getMazeRenderMode() const { return mazeRenderMode; }
 
     void setWireframe(bool enabled);
+    // Use the torch-lit shader variants for world geometry
+    void setTorchLit(bool lit) { torchLit = lit; }
+
+    // Material texture array (wall, ground, gift box, graffiti layers), for
+    // the first-person viewmodel pass
+    unsigned int getMaterialTextures() const { return materialArrayID; }
 
 private:
-    // Maze geometry
-    unsigned int mazeVAO, mazeVBO;
-    int mazeVertexCount;
-    unsigned int groundVAO, groundVBO;
-    int groundVertexCount;
+    // Maze geometry, split into square chunks so a wall change only
+    // remeshes the chunks around it. Every chunk owns a fixed slice (with
+    // slack for door/gate edits) of one shared vertex and index buffer, so
+    // all visible chunks go out in a single multi-draw.
+    static constexpr int MAZE_CHUNK_SIZE = 16;  // cells per chunk side
+    struct MazeChunk {
+        int cellX0, cellY0;                     // first cell covered
+        int baseVertex, vertexCapacity;         // slice of mazeVBO, in vertices
+        int firstIndex, indexCapacity;          // slice of mazeEBO, in indices
+        int indexCount;                         // walls, ceilings and floors
+        glm::vec3 boundsMin, boundsMax;         // world-space AABB
+    };
+    std::vector<MazeChunk> mazeChunks;
+    int mazeChunksX, mazeChunksY;
+    unsigned int mazeVAO, mazeVBO, mazeEBO;
+    std::vector<std::pair<float, int>> visibleChunks;  // (distance, chunk) scratch per frame
+    std::vector<GLsizei> chunkDrawCounts;              // glMultiDrawElementsBaseVertex scratch
+    std::vector<const void*> chunkDrawOffsets;
+    std::vector<GLint> chunkDrawBaseVertices;
+    std::vector<unsigned char> chunkHasVisibleCell;    // per chunk, from the grid pass
+
+    GridVisibility visibility;
+    bool visibilityValid;                   // updateVisibility() ran for this maze
+
+    // Grid vertex pulling (MazeRenderMode::GRID)
+    MazeRenderMode mazeRenderMode;
+    unsigned int gridTextureID;             // GL_R8UI, one CellType per texel
+    unsigned int gridVAO;                   // attribute-less
+    int gridWidth, gridHeight;
 
     // Cube geometry (neutral white, used for player model and cauldron parts)
     unsigned int cubeVAO, cubeVBO;
@@ -71,46 +119,90 @@ private:
     unsigned int sphereVAO, sphereVBO;
     int sphereVertexCount;
 
-    // Gift box geometry and texture (used for all collectables)
+    // Gift box geometry (used for all collectables)
     unsigned int giftBoxVAO, giftBoxVBO;
     int giftBoxVertexCount;
-    unsigned int giftBoxTextureID;
 
-    // Wall & ground textures
-    unsigned int wallTextureID;
-    unsigned int groundTextureID;
+    // Per-instance gift box records, streamed each draw
+    struct ItemInstance {
+        glm::vec3 position;
+        float phase;    // spin offset in degrees
+    };
+    std::vector<ItemInstance> itemInstances;
+    StreamBuffer* stream;
+
+    // Exit gateway: one instance of the unit cube per block, laid out once
+    // around the exit cell's centre. Pulsing, the bobbing beacon and its
+    // orbiting sparks are evaluated in exit_vertex.glsl from time.
+    struct ExitInstance {
+        glm::vec3 centre;   // relative to the exit position, or to a moving block's animated one
+        glm::vec3 scale;
+        glm::vec3 color;
+        glm::vec4 pulse;    // brightness = x + y * sin(z * time + w)
+        glm::vec2 motion;   // EXIT_MOTION_* kind, spark index
+    };
+    unsigned int exitVAO, exitInstanceVBO;
+    int exitInstanceCount;
+    glm::vec2 exitBoundsMin, exitBoundsMax;   // XZ footprint relative to the exit position
+
+    // Enemy geometry (body + eyes, 9-float pos/color/normal)
+    unsigned int enemyVAO, enemyVBO;
+    int enemyVertexCount;
+
+    // Per-instance enemy records, streamed each draw
+    struct EnemyInstance {
+        glm::vec3 position;
+        float heading;  // yaw in radians, 0 = facing +Z
+    };
+    std::vector<EnemyInstance> enemyInstances;
+
+    // Every material and decal texture, one layer each of a single
+    // GL_TEXTURE_2D_ARRAY: wall, ground, gift box, then the graffiti
+    // variants. Shaders pick the layer per vertex, so nothing rebinds.
+    struct TextureImage {
+        int width, height;
+        std::vector<unsigned char> rgba;
+    };
+    unsigned int materialArrayID;
+    int materialLayerSize;                  // width = height of every layer
+    int graffitiLayerCount;
 
-    // Graffiti system
-    std::vector<unsigned int> graffitiTextureIDs;
+    // Graffiti system: one stream, texture layer per vertex
     unsigned int graffitiVAO, graffitiVBO;
     int graffitiVertexCount;
-
-    // Batch rendering info for graffiti (rebuilt per buildMazeMesh)
-    struct GraffitiBatchInfo {
-        int startVertex;
-        int vertexCount;
-        int textureIdx;
-    };
-    std::vector<GraffitiBatchInfo> graffitiBatchInfos_;
+    std::vector<std::pair<int,int>> graffitiDecalCells;  // open cell each decal faces, in VBO order
+    std::vector<GLint> graffitiFirsts;                    // glMultiDrawArrays scratch
+    std::vector<GLsizei> graffitiCounts;
 
     // Graffiti config: filenames to load from textures/graffiti/
     static const std::vector<std::string> GRAFFITI_FILES;
     static constexpr float GRAFFITI_CHANCE = 0.05f; // 5% chance per eligible wall face
 
-    // Dynamic scratch buffers for cauldron rendering
-    unsigned int scratchVAO, scratchVBO;
-
     bool wireframe;
+    bool torchLit;
+
+    unsigned litFeatures() const;
 
     void buildCubeMesh();
     void buildPyramidMesh();
     void buildSphereMesh();
     void buildGiftBoxMesh();
-    void generateWallTexture();
-    void generateGroundTexture();
-    void generateGiftBoxTexture();
-    void generateGraffitiTextures();
+    void buildEnemyMesh();
+    void buildExitZoneMesh();
+    void drawItemInstances();
+    void drawEnemyInstances();
+    TextureImage generateWallTexture();
+    TextureImage generateGroundTexture();
+    TextureImage generateGiftBoxTexture();
+    std::vector<TextureImage> generateGraffitiTextures();
+    void buildMaterialArray();
+    static void resampleLayer(const TextureImage& image, int size, std::vector<unsigned char>& out);
     void buildGraffitiMesh(const Maze& maze);
+    void buildChunkMesh(const Maze& maze, const MazeChunk& chunk,
+                        std::vector<MazeVertex>& verts, std::vector<uint16_t>& indices) const;
+    void uploadMazeChunks(const Maze& maze);
+    void uploadGridTexture(const Maze& maze);
+    void destroyMazeChunks();
 
     void addCube(std::vector<float>& verts,
                  float x, float y, float z,
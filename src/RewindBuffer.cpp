@@ -0,0 +1,159 @@
+#include "RewindBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+// Record layout in the ring:
+//   u32 prevSize | u32 payloadLen | payload | u32 recordLen
+// Payload is a sequence of tokens: u16 zeroRun | u16 literalLen | literal bytes
+static const size_t RECORD_OVERHEAD = 12;
+static const size_t MAX_RUN = 0xFFFF;
+
+static void putU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)(v & 0xFF));
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static void putU32(uint8_t* dst, uint32_t v) {
+    std::memcpy(dst, &v, sizeof(v));
+}
+
+static uint32_t getU32(const uint8_t* src) {
+    uint32_t v;
+    std::memcpy(&v, src, sizeof(v));
+    return v;
+}
+
+// XOR of a and b (zero-padded to the longer one), zero-run-length encoded
+static void encodeDelta(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b,
+                        std::vector<uint8_t>& payload) {
+    size_t n = std::max(a.size(), b.size());
+    auto at = [&](size_t i) -> uint8_t {
+        uint8_t x = i < a.size() ? a[i] : 0;
+        uint8_t y = i < b.size() ? b[i] : 0;
+        return x ^ y;
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        size_t zeros = 0;
+        while (i < n && zeros < MAX_RUN && at(i) == 0) { i++; zeros++; }
+
+        // Literal runs until four zero bytes in a row (a new token is cheaper)
+        size_t litStart = i, litLen = 0;
+        while (i < n && litLen + 5 <= MAX_RUN) {
+            size_t z = 0;
+            while (z < 4 && i + z < n && at(i + z) == 0) z++;
+            if (z == 4 || i + z == n) break;
+            i += z + 1;
+            litLen += z + 1;
+        }
+        if (zeros == 0 && litLen == 0) break;   // only trailing zeros remain
+
+        putU16(payload, (uint16_t)zeros);
+        putU16(payload, (uint16_t)litLen);
+        for (size_t k = 0; k < litLen; k++) payload.push_back(at(litStart + k));
+    }
+}
+
+RewindBuffer::RewindBuffer(size_t capacityBytes)
+    : ring(capacityBytes), head(0), tail(0), used(0), frames(0), hasLatest(false)
+{
+}
+
+void RewindBuffer::clear() {
+    head = tail = used = 0;
+    frames = 0;
+    latest.clear();
+    hasLatest = false;
+}
+
+void RewindBuffer::writeRing(size_t pos, const void* data, size_t size) {
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    size_t first = std::min(size, ring.size() - pos);
+    std::memcpy(ring.data() + pos, src, first);
+    std::memcpy(ring.data(), src + first, size - first);
+}
+
+void RewindBuffer::readRing(size_t pos, void* data, size_t size) const {
+    uint8_t* dst = static_cast<uint8_t*>(data);
+    size_t first = std::min(size, ring.size() - pos);
+    std::memcpy(dst, ring.data() + pos, first);
+    std::memcpy(dst + first, ring.data(), size - first);
+}
+
+void RewindBuffer::dropOldest() {
+    uint8_t header[8];
+    readRing(tail, header, sizeof(header));
+    size_t len = RECORD_OVERHEAD + getU32(header + 4);
+    tail = (tail + len) % ring.size();
+    used -= len;
+    frames--;
+}
+
+void RewindBuffer::push(const std::vector<uint8_t>& snapshot) {
+    if (!hasLatest) {
+        latest = snapshot;
+        hasLatest = true;
+        return;
+    }
+
+    record.assign(8, 0);
+    encodeDelta(latest, snapshot, record);
+    size_t payloadLen = record.size() - 8;
+    size_t len = payloadLen + RECORD_OVERHEAD;
+    putU32(record.data(), (uint32_t)latest.size());
+    putU32(record.data() + 4, (uint32_t)payloadLen);
+    record.resize(len);
+    putU32(record.data() + len - 4, (uint32_t)len);
+
+    if (len > ring.size()) {
+        // A single delta larger than the whole ring: history restarts here
+        clear();
+        latest = snapshot;
+        hasLatest = true;
+        return;
+    }
+
+    while (ring.size() - used < len) dropOldest();
+    writeRing(head, record.data(), len);
+    head = (head + len) % ring.size();
+    used += len;
+    frames++;
+    latest = snapshot;
+}
+
+bool RewindBuffer::stepBack(std::vector<uint8_t>& out) {
+    if (frames == 0) return false;
+
+    uint8_t trailer[4];
+    readRing((head + ring.size() - 4) % ring.size(), trailer, sizeof(trailer));
+    size_t len = getU32(trailer);
+    size_t start = (head + ring.size() - len) % ring.size();
+    record.resize(len);
+    readRing(start, record.data(), len);
+
+    size_t prevSize = getU32(record.data());
+    size_t payloadLen = getU32(record.data() + 4);
+    const uint8_t* p = record.data() + 8;
+    const uint8_t* end = p + payloadLen;
+
+    // latest XOR delta = previous tick
+    latest.resize(std::max(latest.size(), prevSize), 0);
+    size_t i = 0;
+    while (p + 4 <= end) {
+        size_t zeros = p[0] | (p[1] << 8);
+        size_t litLen = p[2] | (p[3] << 8);
+        p += 4;
+        i += zeros;
+        for (size_t k = 0; k < litLen; k++) latest[i + k] ^= p[k];
+        p += litLen;
+        i += litLen;
+    }
+    latest.resize(prevSize);
+
+    head = start;
+    used -= len;
+    frames--;
+    out = latest;
+    return true;
+}
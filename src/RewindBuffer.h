@@ -0,0 +1,48 @@
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-size byte ring of per-tick snapshots for rewinding.
+//
+// Only the newest snapshot is kept in full. Each ring record holds the XOR
+// of two consecutive snapshots, run-length encoded (consecutive ticks differ
+// in a few bytes, so the XOR is mostly zero runs). Walking back applies the
+// newest record to the full snapshot to recover the tick before it. When
+// the ring is full the oldest records are dropped, so memory stays bounded.
+class RewindBuffer {
+public:
+    explicit RewindBuffer(size_t capacityBytes = 2 * 1024 * 1024);
+
+    void clear();
+
+    // Record the snapshot for the tick that just finished
+    void push(const std::vector<uint8_t>& snapshot);
+
+    // Step one recorded tick back; writes that tick's snapshot into out.
+    // Returns false when no older tick is left.
+    bool stepBack(std::vector<uint8_t>& out);
+
+    int getFrameCount() const { return frames; }
+    size_t getUsedBytes() const { return used; }
+    size_t getCapacity() const { return ring.size(); }
+
+private:
+    std::vector<uint8_t> ring;
+    size_t head;      // write position (one past the newest record)
+    size_t tail;      // oldest record
+    size_t used;
+    int frames;
+
+    std::vector<uint8_t> latest;    // full snapshot of the newest tick
+    bool hasLatest;
+    std::vector<uint8_t> record;    // scratch: encoded record
+
+    void writeRing(size_t pos, const void* data, size_t size);
+    void readRing(size_t pos, void* data, size_t size) const;
+    void dropOldest();
+};
+
+#endif
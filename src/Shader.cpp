@@ -1,11 +1,14 @@
 #include "Shader.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string vertexCode   = readFile(vertexPath);
-    std::string fragmentCode = readFile(fragmentPath);
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath,
+               const std::string& defines) {
+    std::string vertexCode   = insertDefines(readFile(vertexPath), defines);
+    std::string fragmentCode = insertDefines(readFile(fragmentPath), defines);
 
     unsigned int vertex   = compileShader(GL_VERTEX_SHADER, vertexCode);
     unsigned int fragment = compileShader(GL_FRAGMENT_SHADER, fragmentCode);
@@ -25,6 +28,8 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    if (success) reflectUniforms();
 }
 
 Shader::~Shader() {
@@ -35,32 +40,99 @@ void Shader::use() const {
     glUseProgram(ID);
 }
 
-void Shader::setBool(const std::string& name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+// Resolve every active uniform once, instead of a glGetUniformLocation per
+// set call
+void Shader::reflectUniforms() {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(std::max(maxLength, 1));
+
+    uniforms.clear();
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+        GLint location = glGetUniformLocation(ID, name.data());
+        if (location < 0) continue;   // block member
+        // Arrays report "name[0]"; register them under the bare name
+        if (length > 3 && std::strcmp(name.data() + length - 3, "[0]") == 0) length -= 3;
+
+        UniformSlot slot{};
+        slot.hash = UniformId::fnv1a(name.data(), (size_t)length);
+        slot.location = location;
+        uniforms.push_back(slot);
+    }
+
+    std::sort(uniforms.begin(), uniforms.end(),
+              [](const UniformSlot& a, const UniformSlot& b) { return a.hash < b.hash; });
+    for (size_t i = 1; i < uniforms.size(); i++) {
+        if (uniforms[i].hash == uniforms[i - 1].hash)
+            std::cerr << "Shader " << ID << ": uniform name hash collision, rename a uniform\n";
+    }
+}
+
+// The slot for name if the program has it and value differs from the last
+// one sent (the cache is updated); nullptr when there is nothing to do
+Shader::UniformSlot* Shader::changedUniform(UniformId name, const void* value, size_t size) const {
+    auto it = std::lower_bound(uniforms.begin(), uniforms.end(), name.hash,
+                               [](const UniformSlot& u, uint32_t h) { return u.hash < h; });
+    if (it == uniforms.end() || it->hash != name.hash) return nullptr;
+    if (it->cached && std::memcmp(it->value, value, size) == 0) return nullptr;
+    std::memcpy(it->value, value, size);
+    it->cached = true;
+    return &*it;
+}
+
+void Shader::setBool(UniformId name, bool value) const {
+    setInt(name, (int)value);
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setInt(UniformId name, int value) const {
+    if (UniformSlot* u = changedUniform(name, &value, sizeof(value)))
+        glUniform1i(u->location, value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setFloat(UniformId name, float value) const {
+    if (UniformSlot* u = changedUniform(name, &value, sizeof(value)))
+        glUniform1f(u->location, value);
 }
 
-void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), value.x, value.y);
+void Shader::setVec2(UniformId name, const glm::vec2& value) const {
+    if (UniformSlot* u = changedUniform(name, &value[0], sizeof(float) * 2))
+        glUniform2f(u->location, value.x, value.y);
 }
 
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z);
+void Shader::setIVec2(UniformId name, int x, int y) const {
+    const int value[2] = {x, y};
+    if (UniformSlot* u = changedUniform(name, value, sizeof(value)))
+        glUniform2i(u->location, x, y);
 }
 
-void Shader::setVec4(const std::string& name, const glm::vec4& value) const {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), value.x, value.y, value.z, value.w);
+void Shader::setVec3(UniformId name, const glm::vec3& value) const {
+    if (UniformSlot* u = changedUniform(name, &value[0], sizeof(float) * 3))
+        glUniform3f(u->location, value.x, value.y, value.z);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& value) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &value[0][0]);
+void Shader::setVec4(UniformId name, const glm::vec4& value) const {
+    if (UniformSlot* u = changedUniform(name, &value[0], sizeof(float) * 4))
+        glUniform4f(u->location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::setMat3(UniformId name, const glm::mat3& value) const {
+    if (UniformSlot* u = changedUniform(name, &value[0][0], sizeof(float) * 9))
+        glUniformMatrix3fv(u->location, 1, GL_FALSE, &value[0][0]);
+}
+
+void Shader::setMat4(UniformId name, const glm::mat4& value) const {
+    if (UniformSlot* u = changedUniform(name, &value[0][0], sizeof(float) * 16))
+        glUniformMatrix4fv(u->location, 1, GL_FALSE, &value[0][0]);
+}
+
+void Shader::setModel(const glm::mat4& model) const {
+    setMat4("model", model);
+    setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(model))));
 }
 
 unsigned int Shader::compileShader(unsigned int type, const std::string& source) {
@@ -91,3 +163,11 @@ std::string Shader::readFile(const std::string& path) {
     ss << file.rdbuf();
     return ss.str();
 }
+
+// #version must stay the first line, so defines go on the line after it
+std::string Shader::insertDefines(const std::string& source, const std::string& defines) {
+    if (defines.empty()) return source;
+    size_t lineEnd = source.find('\n', source.find("#version"));
+    if (lineEnd == std::string::npos) return defines + source;
+    return source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1);
+}
@@ -3,28 +3,76 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// Uniform handle: the FNV-1a hash of the uniform's name. It converts
+// implicitly from a string literal and the hash is constexpr, so
+// shader.setFloat("fogDensity", ...) costs no allocation and no driver
+// lookup; the program's location table is keyed by the same hash.
+struct UniformId {
+    uint32_t hash;
+
+    template <size_t N>
+    constexpr UniformId(const char (&name)[N]) : hash(fnv1a(name, N - 1)) {}
+
+    static constexpr uint32_t fnv1a(const char* s, size_t len) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; i++) {
+            h ^= (uint8_t)s[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+};
 
 class Shader {
 public:
     unsigned int ID;
 
     Shader() : ID(0) {}
-    Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    // defines ("#define NAME\n" lines, and shared declarations such as
+    // FrameUniforms::GLSL_BLOCKS) go in right after each source's #version
+    // line, to build a permutation of the same files
+    Shader(const std::string& vertexPath, const std::string& fragmentPath,
+           const std::string& defines = "");
     ~Shader();
 
     void use() const;
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec4(const std::string& name, const glm::vec4& value) const;
-    void setMat4(const std::string& name, const glm::mat4& value) const;
+    // Setters skip the glUniform call when the value matches the last one
+    // sent to this program, and ignore names the linker optimised away
+    void setBool(UniformId name, bool value) const;
+    void setInt(UniformId name, int value) const;
+    void setFloat(UniformId name, float value) const;
+    void setVec2(UniformId name, const glm::vec2& value) const;
+    void setIVec2(UniformId name, int x, int y) const;
+    void setVec3(UniformId name, const glm::vec3& value) const;
+    void setVec4(UniformId name, const glm::vec4& value) const;
+    void setMat3(UniformId name, const glm::mat3& value) const;
+    void setMat4(UniformId name, const glm::mat4& value) const;
+    // Per-object transform for vertex.glsl: "model" plus its normal matrix
+    // (inverse transpose of the upper 3x3), worked out here once per object
+    // rather than in every vertex
+    void setModel(const glm::mat4& model) const;
 
 private:
+    // One entry per active uniform, filled by reflection after linking and
+    // sorted by name hash
+    struct UniformSlot {
+        uint32_t hash;
+        GLint location;
+        bool cached;                // value[] mirrors the program's state
+        unsigned char value[64];    // last value sent, up to a mat4
+    };
+    mutable std::vector<UniformSlot> uniforms;
+
+    void reflectUniforms();
+    UniformSlot* changedUniform(UniformId name, const void* value, size_t size) const;
     unsigned int compileShader(unsigned int type, const std::string& source);
     std::string readFile(const std::string& path);
+    static std::string insertDefines(const std::string& source, const std::string& defines);
 };
 
 #endif
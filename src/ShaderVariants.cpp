@@ -0,0 +1,29 @@
+#include "ShaderVariants.h"
+#include "FrameUniforms.h"
+
+static const char* const FEATURE_DEFINES[ShaderVariants::FEATURE_COUNT] = {
+    "USE_TEXTURE", "ALPHA_TEST", "TORCH_LIGHT", "EDGE_OUTLINE", "STATIC_GEOMETRY"
+};
+
+ShaderVariants::ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath)
+{
+}
+
+Shader& ShaderVariants::get(unsigned features) {
+    features &= (1u << FEATURE_COUNT) - 1;
+    std::unique_ptr<Shader>& variant = variants[features];
+    if (!variant) {
+        std::string defines;
+        for (int i = 0; i < FEATURE_COUNT; i++)
+            if (features & (1u << i)) defines += std::string("#define ") + FEATURE_DEFINES[i] + "\n";
+        defines += FrameUniforms::GLSL_BLOCKS;
+        variant.reset(new Shader(vertexPath, fragmentPath, defines));
+        FrameUniforms::attach(variant->ID);
+    }
+    return *variant;
+}
+
+void ShaderVariants::warm(std::initializer_list<unsigned> featureSets) {
+    for (unsigned features : featureSets) get(features);
+}
@@ -0,0 +1,38 @@
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include "Shader.h"
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+// Compile-time permutations of one vertex/fragment pair. Each feature bit
+// becomes a #define in both sources, so a variant carries no runtime
+// branch for a feature it lacks; in particular only ALPHA_TEST variants
+// contain a discard, and everything else keeps early depth testing.
+// Variants are built on first use and cached for the pair's lifetime.
+class ShaderVariants {
+public:
+    enum Feature : unsigned {
+        TEXTURE      = 1u << 0,   // USE_TEXTURE: sample materialTextures
+        ALPHA_TEST   = 1u << 1,   // ALPHA_TEST: discard transparent texels (decals)
+        TORCH        = 1u << 2,   // TORCH_LIGHT: torch point light
+        EDGE_OUTLINE = 1u << 3,   // EDGE_OUTLINE: darken cell edges
+        STATIC       = 1u << 4,   // STATIC_GEOMETRY: vertices already in world space, no model transform
+    };
+    static constexpr int FEATURE_COUNT = 5;
+
+    ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // The variant with exactly these features
+    Shader& get(unsigned features);
+
+    // Build variants up front so the first frame that needs them doesn't stall
+    void warm(std::initializer_list<unsigned> featureSets);
+
+private:
+    std::string vertexPath, fragmentPath;
+    std::unique_ptr<Shader> variants[1 << FEATURE_COUNT];
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "SkyRenderer.h"
+#include "FrameUniforms.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 #include <iostream>
@@ -10,20 +11,25 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// Inline sky shader sources (simple 2D colored quads, same as HUD format)
+// Inline sky shader sources. Meshes are static: each vertex carries
+// weights into a per-draw palette (three colours as matrix columns), so
+// time-of-day colours change through one uniform instead of a re-upload.
+// The vertex source is compiled after a #version line and
+// FrameUniforms::GLSL_BLOCKS, which declares FrameCamera.
 static const char* SKY_VERTEX_SRC = R"(
-#version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
+layout (location = 1) in vec3 aWeights;
 
 out vec3 vColor;
 
-uniform mat4 viewProj;
+uniform mat4 model;
+uniform mat3 palette;
 
 void main() {
-    gl_Position = viewProj * vec4(aPos, 1.0);
+    // Rotation only: the sky stays centred on the camera
+    gl_Position = projection * mat4(mat3(view)) * model * vec4(aPos, 1.0);
     gl_Position.z = gl_Position.w; // push to far plane
-    vColor = aColor;
+    vColor = palette * aWeights;
 }
 )";
 
@@ -40,8 +46,8 @@ void main() {
 SkyRenderer::SkyRenderer()
     : skyVAO(0), skyVBO(0), sunVAO(0), sunVBO(0)
     , starVAO(0), starVBO(0)
-    , skyVertexCount(0), starVertexCount(0)
-    , skyShaderID(0)
+    , skyVertexCount(0), sunVertexCount(0), starVertexCount(0)
+    , skyShaderID(0), skyModelLoc(-1), skyPaletteLoc(-1)
     , timeOfDay(0.0f)  // start at midnight
 {
 }
@@ -62,7 +68,8 @@ void SkyRenderer::cleanup() {
 
 void SkyRenderer::compileSkyShader() {
     unsigned int vert = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vert, 1, &SKY_VERTEX_SRC, nullptr);
+    const char* vertexSources[] = {"#version 330 core\n", FrameUniforms::GLSL_BLOCKS, SKY_VERTEX_SRC};
+    glShaderSource(vert, 3, vertexSources, nullptr);
     glCompileShader(vert);
     int success;
     glGetShaderiv(vert, GL_COMPILE_STATUS, &success);
@@ -95,10 +102,15 @@ void SkyRenderer::compileSkyShader() {
 
     glDeleteShader(vert);
     glDeleteShader(frag);
+
+    FrameUniforms::attach(skyShaderID);
+    skyModelLoc = glGetUniformLocation(skyShaderID, "model");
+    skyPaletteLoc = glGetUniformLocation(skyShaderID, "palette");
 }
 
 void SkyRenderer::init() {
     compileSkyShader();
+    buildDomeMesh();
     buildSunMesh();
     buildStarMesh();
 }
@@ -201,25 +213,12 @@ float SkyRenderer::getAmbientLevel() const {
     return night;
 }
 
-void SkyRenderer::buildSunMesh() {
-    // Blocky sun/moon: a simple quad (placeholder, rebuilt dynamically in render)
-    std::vector<float> verts;
-    float s = 1.0f;
-
-    // Two triangles for a quad
-    // Vertex format: pos(3) + color(3)
-    float c = 1.0f; // placeholder color, overridden per-frame
-    verts.insert(verts.end(), {-s, -s, 0.0f, c, c, c});
-    verts.insert(verts.end(), { s, -s, 0.0f, c, c, c});
-    verts.insert(verts.end(), { s,  s, 0.0f, c, c, c});
-    verts.insert(verts.end(), {-s, -s, 0.0f, c, c, c});
-    verts.insert(verts.end(), { s,  s, 0.0f, c, c, c});
-    verts.insert(verts.end(), {-s,  s, 0.0f, c, c, c});
-
-    glGenVertexArrays(1, &sunVAO);
-    glGenBuffers(1, &sunVBO);
-    glBindVertexArray(sunVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, sunVBO);
+// Vertex format for every sky mesh: pos(3) + palette weights(3)
+static void uploadSkyMesh(unsigned int& vao, unsigned int& vbo, const std::vector<float>& verts) {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -228,6 +227,115 @@ void SkyRenderer::buildSunMesh() {
     glBindVertexArray(0);
 }
 
+void SkyRenderer::buildDomeMesh() {
+    // Hemisphere whose colour runs from the horizon (palette column 0) to
+    // the top of the sky (column 1) with elevation
+    std::vector<float> verts;
+    int slices = 16;
+    int stacks = 8;
+    float radius = 100.0f;
+
+    for (int i = 0; i < stacks; i++) {
+        float phi0 = (float)i / stacks * ((float)M_PI / 2.0f);
+        float phi1 = (float)(i + 1) / stacks * ((float)M_PI / 2.0f);
+
+        // Colour interpolation based on elevation
+        float t0 = (float)i / stacks;
+        float t1 = (float)(i + 1) / stacks;
+
+        for (int j = 0; j < slices; j++) {
+            float theta0 = 2.0f * (float)M_PI * j / slices;
+            float theta1 = 2.0f * (float)M_PI * (j + 1) / slices;
+
+            float x00 = radius * std::cos(phi0) * std::cos(theta0);
+            float y00 = radius * std::sin(phi0);
+            float z00 = radius * std::cos(phi0) * std::sin(theta0);
+
+            float x10 = radius * std::cos(phi0) * std::cos(theta1);
+            float y10 = radius * std::sin(phi0);
+            float z10 = radius * std::cos(phi0) * std::sin(theta1);
+
+            float x01 = radius * std::cos(phi1) * std::cos(theta0);
+            float y01 = radius * std::sin(phi1);
+            float z01 = radius * std::cos(phi1) * std::sin(theta0);
+
+            float x11 = radius * std::cos(phi1) * std::cos(theta1);
+            float y11 = radius * std::sin(phi1);
+            float z11 = radius * std::cos(phi1) * std::sin(theta1);
+
+            // Triangle 1
+            verts.insert(verts.end(), {x00, y00, z00, 1.0f - t0, t0, 0.0f});
+            verts.insert(verts.end(), {x10, y10, z10, 1.0f - t0, t0, 0.0f});
+            verts.insert(verts.end(), {x11, y11, z11, 1.0f - t1, t1, 0.0f});
+
+            // Triangle 2
+            verts.insert(verts.end(), {x00, y00, z00, 1.0f - t0, t0, 0.0f});
+            verts.insert(verts.end(), {x11, y11, z11, 1.0f - t1, t1, 0.0f});
+            verts.insert(verts.end(), {x01, y01, z01, 1.0f - t1, t1, 0.0f});
+        }
+    }
+
+    // Bottom hemisphere (below horizon - darker)
+    for (int j = 0; j < slices; j++) {
+        float theta0 = 2.0f * (float)M_PI * j / slices;
+        float theta1 = 2.0f * (float)M_PI * (j + 1) / slices;
+
+        float x0 = radius * std::cos(theta0);
+        float z0 = radius * std::sin(theta0);
+        float x1 = radius * std::cos(theta1);
+        float z1 = radius * std::sin(theta1);
+
+        verts.insert(verts.end(), {0.0f, -radius * 0.3f, 0.0f, 0.5f, 0.0f, 0.0f});
+        verts.insert(verts.end(), {x0, 0.0f, z0, 1.0f, 0.0f, 0.0f});
+        verts.insert(verts.end(), {x1, 0.0f, z1, 1.0f, 0.0f, 0.0f});
+    }
+
+    skyVertexCount = (int)(verts.size() / 6);
+    uploadSkyMesh(skyVAO, skyVBO, verts);
+}
+
+void SkyRenderer::buildSunMesh() {
+    // Blocky sun/moon disc (palette column 0 = body colour) followed by its
+    // glow halo (centre from column 0, rim from column 1), drawn in that
+    // order as one mesh
+    std::vector<float> verts;
+    float bSize = 0.3f;
+    auto addBlock = [&](float ox, float oy, float w) {
+        verts.insert(verts.end(), {ox - bSize, oy - bSize, 0.0f, w, 0.0f, 0.0f});
+        verts.insert(verts.end(), {ox + bSize, oy - bSize, 0.0f, w, 0.0f, 0.0f});
+        verts.insert(verts.end(), {ox + bSize, oy + bSize, 0.0f, w, 0.0f, 0.0f});
+        verts.insert(verts.end(), {ox - bSize, oy - bSize, 0.0f, w, 0.0f, 0.0f});
+        verts.insert(verts.end(), {ox + bSize, oy + bSize, 0.0f, w, 0.0f, 0.0f});
+        verts.insert(verts.end(), {ox - bSize, oy + bSize, 0.0f, w, 0.0f, 0.0f});
+    };
+
+    // 3x3 pixelated disc with dimmer corners, plus one block on each side
+    for (int bx = -1; bx <= 1; bx++)
+        for (int by = -1; by <= 1; by++)
+            addBlock(bx * bSize * 2.0f, by * bSize * 2.0f,
+                     (std::abs(bx) + std::abs(by) == 2) ? 0.85f : 1.0f);
+    for (int d = -1; d <= 1; d += 2) {
+        addBlock(0.0f, d * bSize * 4.0f, 0.9f);
+        addBlock(d * bSize * 4.0f, 0.0f, 0.9f);
+    }
+
+    // Glow halo
+    int glowSegments = 16;
+    float glowRadius = bSize * 8.0f;
+    for (int seg = 0; seg < glowSegments; seg++) {
+        float a0 = 2.0f * (float)M_PI * seg / glowSegments;
+        float a1 = 2.0f * (float)M_PI * (seg + 1) / glowSegments;
+        verts.insert(verts.end(), {0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f});
+        verts.insert(verts.end(), {glowRadius * std::cos(a0), glowRadius * std::sin(a0), 0.0f,
+                                   0.0f, 1.0f, 0.0f});
+        verts.insert(verts.end(), {glowRadius * std::cos(a1), glowRadius * std::sin(a1), 0.0f,
+                                   0.0f, 1.0f, 0.0f});
+    }
+
+    sunVertexCount = (int)(verts.size() / 6);
+    uploadSkyMesh(sunVAO, sunVBO, verts);
+}
+
 void SkyRenderer::buildStarMesh() {
     // Generate random pixel-style stars scattered across the sky dome
     std::vector<float> verts;
@@ -281,119 +389,27 @@ void SkyRenderer::buildStarMesh() {
     }
 
     starVertexCount = (int)(verts.size() / 6);
-
-    glGenVertexArrays(1, &starVAO);
-    glGenBuffers(1, &starVBO);
-    glBindVertexArray(starVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, starVBO);
-    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glBindVertexArray(0);
+    uploadSkyMesh(starVAO, starVBO, verts);
 }
 
-void SkyRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
+void SkyRenderer::render(const glm::mat4& view) {
     if (!skyShaderID) return;
 
     glUseProgram(skyShaderID);
 
     // Remove translation from view matrix for skybox effect
     glm::mat4 skyView = glm::mat4(glm::mat3(view));
-    glm::mat4 viewProj = projection * skyView;
-
-    int vpLoc = glGetUniformLocation(skyShaderID, "viewProj");
-    glUniformMatrix4fv(vpLoc, 1, GL_FALSE, &viewProj[0][0]);
-
-    // Build sky dome vertices dynamically based on time of day
-    glm::vec3 topColor = getSkyTopColor();
-    glm::vec3 horizonColor = getSkyHorizonColor();
-
-    std::vector<float> skyVerts;
-
-    // Create a hemisphere of triangles with gradient coloring
-    int slices = 16;
-    int stacks = 8;
-    float radius = 100.0f;
-
-    for (int i = 0; i < stacks; i++) {
-        float phi0 = (float)i / stacks * ((float)M_PI / 2.0f);
-        float phi1 = (float)(i + 1) / stacks * ((float)M_PI / 2.0f);
-
-        // Color interpolation based on elevation
-        float t0 = (float)i / stacks;
-        float t1 = (float)(i + 1) / stacks;
-        glm::vec3 c0 = glm::mix(horizonColor, topColor, t0);
-        glm::vec3 c1 = glm::mix(horizonColor, topColor, t1);
-
-        for (int j = 0; j < slices; j++) {
-            float theta0 = 2.0f * (float)M_PI * j / slices;
-            float theta1 = 2.0f * (float)M_PI * (j + 1) / slices;
-
-            float x00 = radius * std::cos(phi0) * std::cos(theta0);
-            float y00 = radius * std::sin(phi0);
-            float z00 = radius * std::cos(phi0) * std::sin(theta0);
-
-            float x10 = radius * std::cos(phi0) * std::cos(theta1);
-            float y10 = radius * std::sin(phi0);
-            float z10 = radius * std::cos(phi0) * std::sin(theta1);
-
-            float x01 = radius * std::cos(phi1) * std::cos(theta0);
-            float y01 = radius * std::sin(phi1);
-            float z01 = radius * std::cos(phi1) * std::sin(theta0);
-
-            float x11 = radius * std::cos(phi1) * std::cos(theta1);
-            float y11 = radius * std::sin(phi1);
-            float z11 = radius * std::cos(phi1) * std::sin(theta1);
-
-            // Triangle 1
-            skyVerts.insert(skyVerts.end(), {x00, y00, z00, c0.r, c0.g, c0.b});
-            skyVerts.insert(skyVerts.end(), {x10, y10, z10, c0.r, c0.g, c0.b});
-            skyVerts.insert(skyVerts.end(), {x11, y11, z11, c1.r, c1.g, c1.b});
-
-            // Triangle 2
-            skyVerts.insert(skyVerts.end(), {x00, y00, z00, c0.r, c0.g, c0.b});
-            skyVerts.insert(skyVerts.end(), {x11, y11, z11, c1.r, c1.g, c1.b});
-            skyVerts.insert(skyVerts.end(), {x01, y01, z01, c1.r, c1.g, c1.b});
-        }
-    }
-
-    // Bottom hemisphere (below horizon - darker)
-    for (int j = 0; j < slices; j++) {
-        float theta0 = 2.0f * (float)M_PI * j / slices;
-        float theta1 = 2.0f * (float)M_PI * (j + 1) / slices;
-
-        float x0 = radius * std::cos(theta0);
-        float z0 = radius * std::sin(theta0);
-        float x1 = radius * std::cos(theta1);
-        float z1 = radius * std::sin(theta1);
-
-        glm::vec3 bc = horizonColor * 0.5f;
+    glm::mat4 identity(1.0f);
+    glUniformMatrix4fv(skyModelLoc, 1, GL_FALSE, &identity[0][0]);
 
-        skyVerts.insert(skyVerts.end(), {0.0f, -radius * 0.3f, 0.0f, bc.r, bc.g, bc.b});
-        skyVerts.insert(skyVerts.end(), {x0, 0.0f, z0, horizonColor.r, horizonColor.g, horizonColor.b});
-        skyVerts.insert(skyVerts.end(), {x1, 0.0f, z1, horizonColor.r, horizonColor.g, horizonColor.b});
-    }
-
-    skyVertexCount = (int)(skyVerts.size() / 6);
-
-    if (!skyVAO) {
-        glGenVertexArrays(1, &skyVAO);
-        glGenBuffers(1, &skyVBO);
-    }
-
-    glBindVertexArray(skyVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, skyVBO);
-    glBufferData(GL_ARRAY_BUFFER, skyVerts.size() * sizeof(float), skyVerts.data(), GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Sky dome: time-of-day gradient from horizon to top
+    glm::mat3 palette(getSkyHorizonColor(), getSkyTopColor(), glm::vec3(0.0f));
+    glUniformMatrix3fv(skyPaletteLoc, 1, GL_FALSE, &palette[0][0]);
 
     // Render sky with depth write disabled
     glDepthMask(GL_FALSE);
     glDisable(GL_CULL_FACE);
+    glBindVertexArray(skyVAO);
     glDrawArrays(GL_TRIANGLES, 0, skyVertexCount);
 
     // Render sun (daytime) or moon (nighttime)
@@ -419,88 +435,16 @@ void SkyRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
             glm::mat3 invRot = glm::transpose(rot);
             sunModel = sunModel * glm::mat4(invRot);
             sunModel = glm::scale(sunModel, glm::vec3(sunSize));
+            glUniformMatrix4fv(skyModelLoc, 1, GL_FALSE, &sunModel[0][0]);
+
+            // Body, then the glow halo whose rim fades to a fraction of it
+            float glowAlpha = isDay ? 0.5f : 0.3f;
+            glm::vec3 body = bodyColor * horizonFade;
+            palette = glm::mat3(body, body * glowAlpha, glm::vec3(0.0f));
+            glUniformMatrix3fv(skyPaletteLoc, 1, GL_FALSE, &palette[0][0]);
 
-            glm::mat4 sunVP = projection * skyView * sunModel;
-            glUniformMatrix4fv(vpLoc, 1, GL_FALSE, &sunVP[0][0]);
-
-            // Build pixelated disc mesh
-            std::vector<float> sunVerts;
-            float bSize = 0.3f;
-            for (int bx = -1; bx <= 1; bx++) {
-                for (int by = -1; by <= 1; by++) {
-                    float ox = bx * bSize * 2.0f;
-                    float oy = by * bSize * 2.0f;
-                    float cr = bodyColor.r * horizonFade;
-                    float cg = bodyColor.g * horizonFade;
-                    float cb = bodyColor.b * horizonFade;
-                    if (std::abs(bx) + std::abs(by) == 2) {
-                        cr *= 0.85f; cg *= 0.85f; cb *= 0.85f;
-                    }
-                    sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, cr, cg, cb});
-                    sunVerts.insert(sunVerts.end(), {ox + bSize, oy - bSize, 0.0f, cr, cg, cb});
-                    sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, cr, cg, cb});
-                    sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, cr, cg, cb});
-                    sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, cr, cg, cb});
-                    sunVerts.insert(sunVerts.end(), {ox - bSize, oy + bSize, 0.0f, cr, cg, cb});
-                }
-            }
-            float ecr = bodyColor.r * horizonFade * 0.9f;
-            float ecg = bodyColor.g * horizonFade * 0.9f;
-            float ecb = bodyColor.b * horizonFade * 0.9f;
-            for (int d = -1; d <= 1; d += 2) {
-                float ox = 0.0f, oy = d * bSize * 4.0f;
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-                ox = d * bSize * 4.0f; oy = 0.0f;
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy - bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox + bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-                sunVerts.insert(sunVerts.end(), {ox - bSize, oy + bSize, 0.0f, ecr, ecg, ecb});
-            }
-
-            int sunVCount = (int)(sunVerts.size() / 6);
             glBindVertexArray(sunVAO);
-            glBindBuffer(GL_ARRAY_BUFFER, sunVBO);
-            glBufferData(GL_ARRAY_BUFFER, sunVerts.size() * sizeof(float), sunVerts.data(), GL_DYNAMIC_DRAW);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-            glEnableVertexAttribArray(1);
-            glDrawArrays(GL_TRIANGLES, 0, sunVCount);
-
-            // Glow halo
-            {
-                std::vector<float> glowVerts;
-                int glowSegments = 16;
-                float glowRadius = bSize * 8.0f;
-                float glowAlpha = horizonFade * (isDay ? 0.5f : 0.3f);
-                glm::vec3 glowCol = bodyColor * glowAlpha;
-
-                for (int seg = 0; seg < glowSegments; seg++) {
-                    float a0 = 2.0f * (float)M_PI * seg / glowSegments;
-                    float a1 = 2.0f * (float)M_PI * (seg + 1) / glowSegments;
-                    glowVerts.insert(glowVerts.end(), {0.0f, 0.0f, 0.0f,
-                        bodyColor.r * horizonFade * 0.5f, bodyColor.g * horizonFade * 0.5f, bodyColor.b * horizonFade * 0.5f});
-                    glowVerts.insert(glowVerts.end(), {glowRadius * std::cos(a0), glowRadius * std::sin(a0), 0.0f,
-                        glowCol.r, glowCol.g, glowCol.b});
-                    glowVerts.insert(glowVerts.end(), {glowRadius * std::cos(a1), glowRadius * std::sin(a1), 0.0f,
-                        glowCol.r, glowCol.g, glowCol.b});
-                }
-                int glowVCount = (int)(glowVerts.size() / 6);
-                glBindBuffer(GL_ARRAY_BUFFER, sunVBO);
-                glBufferData(GL_ARRAY_BUFFER, glowVerts.size() * sizeof(float), glowVerts.data(), GL_DYNAMIC_DRAW);
-                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-                glEnableVertexAttribArray(0);
-                glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-                glEnableVertexAttribArray(1);
-                glDrawArrays(GL_TRIANGLES, 0, glowVCount);
-            }
+            glDrawArrays(GL_TRIANGLES, 0, sunVertexCount);
         }
     }
 
@@ -514,9 +458,10 @@ void SkyRenderer::render(const glm::mat4& view, const glm::mat4& projection) {
         else if (t >= 0.78f && t < 0.88f) starBrightness = remap01(t, 0.78f, 0.88f);
 
         if (starBrightness > 0.01f) {
-            // Temporarily scale star colors by brightness
-            // We pass the regular viewProj – star fade is approximate (they just disappear)
-            glUniformMatrix4fv(vpLoc, 1, GL_FALSE, &viewProj[0][0]);
+            // Star colours are baked; the palette scales them by brightness
+            glUniformMatrix4fv(skyModelLoc, 1, GL_FALSE, &identity[0][0]);
+            palette = glm::mat3(starBrightness);
+            glUniformMatrix3fv(skyPaletteLoc, 1, GL_FALSE, &palette[0][0]);
             glBindVertexArray(starVAO);
             glDrawArrays(GL_TRIANGLES, 0, starVertexCount);
         }
@@ -18,8 +18,9 @@ public:
     // Update: advances timeOfDay based on dt
     void update(float dt);
 
-    // Render sky background (call before maze rendering, with depth write off)
-    void render(const glm::mat4& view, const glm::mat4& projection);
+    // Render sky background (call before maze rendering, with depth write
+    // off); the camera comes from the FrameUniforms world view
+    void render(const glm::mat4& view);
 
     // Get current sun/moon direction for lighting
     glm::vec3 getSunDirection() const;
@@ -41,9 +42,11 @@ private:
     unsigned int sunVAO, sunVBO;
     unsigned int starVAO, starVBO;
     int skyVertexCount;
+    int sunVertexCount;                 // disc, then glow halo
     int starVertexCount;
 
     unsigned int skyShaderID;
+    int skyModelLoc, skyPaletteLoc;
 
     // [0,1): 0=midnight, 0.25=sunrise, 0.5=noon, 0.75=sunset
     float timeOfDay;
@@ -52,6 +55,7 @@ private:
     static constexpr float DAY_CYCLE_SPEED = 1.0f / 90.0f;
 
     void compileSkyShader();
+    void buildDomeMesh();
     void buildSunMesh();
     void buildStarMesh();
 
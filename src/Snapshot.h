@@ -0,0 +1,70 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// ── Binary snapshot streams ────────────────────────────────────────────────
+// Raw host-endian POD writes into a byte vector. Snapshots are meant for
+// rewind and suspend/resume on the same build, not as a portable format.
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD values only");
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        if (size == 0) return;
+        size_t offset = out.size();
+        out.resize(offset + size);
+        std::memcpy(out.data() + offset, data, size);
+    }
+
+private:
+    std::vector<uint8_t>& out;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const uint8_t* data, size_t size)
+        : cursor(data), end(data + size), ok(true) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "POD values only");
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readBytes(void* data, size_t size) {
+        if (!ok || (size_t)(end - cursor) < size) { ok = false; return false; }
+        if (size > 0) std::memcpy(data, cursor, size);
+        cursor += size;
+        return true;
+    }
+
+    // Step over size bytes without copying them; returns where they start,
+    // or nullptr (and marks the stream bad) if the payload is too short
+    const uint8_t* skip(size_t size) {
+        if (!ok || (size_t)(end - cursor) < size) { ok = false; return nullptr; }
+        const uint8_t* start = cursor;
+        cursor += size;
+        return start;
+    }
+
+    bool good() const { return ok; }
+    size_t remaining() const { return (size_t)(end - cursor); }
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool ok;
+};
+
+#endif
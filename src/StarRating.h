@@ -30,16 +30,17 @@ struct DifficultyConfig {
     float threeStar;  // seconds
     float twoStar;    // seconds
     const char* name;
+    int numEnemies;
 };
 
 inline DifficultyConfig getDifficultyConfig(Difficulty d) {
     switch (d) {
-        case Difficulty::EASY:      return {15, 15,  5,  60.0f, 120.0f, "EASY"};
-        case Difficulty::MEDIUM:    return {21, 21,  7,  90.0f, 180.0f, "MEDIUM"};
-        case Difficulty::HARD:      return {31, 31, 10, 150.0f, 300.0f, "HARD"};
-        case Difficulty::NIGHTMARE: return {41, 41, 14, 240.0f, 480.0f, "NIGHTMARE"};
+        case Difficulty::EASY:      return {15, 15,  5,  60.0f, 120.0f, "EASY",      1};
+        case Difficulty::MEDIUM:    return {21, 21,  7,  90.0f, 180.0f, "MEDIUM",    2};
+        case Difficulty::HARD:      return {31, 31, 10, 150.0f, 300.0f, "HARD",      4};
+        case Difficulty::NIGHTMARE: return {41, 41, 14, 240.0f, 480.0f, "NIGHTMARE", 8};
     }
-    return {21, 21, 7, 90.0f, 180.0f, "MEDIUM"};
+    return {21, 21, 7, 90.0f, 180.0f, "MEDIUM", 2};
 }
 
 // ── Star calculation ───────────────────────────────────────────────────────
@@ -154,12 +155,4 @@ inline void generateStarOutline(std::vector<float>& verts,
     }
 }
 
-// ── Particle for star burst effect ────────────────────────────────────────
-struct StarParticle {
-    float x, y;      // position (NDC)
-    float vx, vy;    // velocity
-    float life;       // remaining life (seconds)
-    float maxLife;
-};
-
 #endif
@@ -0,0 +1,107 @@
+#include "StreamBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+StreamBuffer::StreamBuffer()
+    : buffer(0), sectionBytes(0), section(0), used(0), sectionReady(false)
+    , fences{}, stats{}, pendingBytes(0), pendingWrites(0)
+{
+}
+
+StreamBuffer::~StreamBuffer() {
+    cleanup();
+}
+
+void StreamBuffer::init(GLsizeiptr bytes) {
+    glGenBuffers(1, &buffer);
+    reallocate(bytes);
+    stats.grows = 0;
+}
+
+void StreamBuffer::cleanup() {
+    for (GLsync& fence : fences) {
+        if (fence) { glDeleteSync(fence); fence = nullptr; }
+    }
+    if (buffer) { glDeleteBuffers(1, &buffer); buffer = 0; }
+}
+
+// (Re)create the ring storage; old fences guard storage that's gone, and
+// draws already queued keep reading the orphaned copy
+void StreamBuffer::reallocate(GLsizeiptr bytes) {
+    for (GLsync& fence : fences) {
+        if (fence) { glDeleteSync(fence); fence = nullptr; }
+    }
+    sectionBytes = bytes;
+    section = 0;
+    used = 0;
+    sectionReady = true;
+    stats.capacity = RING_SECTIONS * sectionBytes;
+    stats.grows++;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, stats.capacity, nullptr, GL_STREAM_DRAW);
+}
+
+GLintptr StreamBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment) {
+    // Wait until the GPU is done with the frame that last used this section
+    if (!sectionReady) {
+        GLsync& fence = fences[section];
+        if (fence) {
+            GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GLuint64(1000000000));
+            if (result != GL_ALREADY_SIGNALED) stats.stalls++;
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        sectionReady = true;
+    }
+
+    GLintptr sectionStart = (GLintptr)section * sectionBytes;
+    GLintptr offset = sectionStart + used;
+    offset = (offset + alignment - 1) / alignment * alignment;
+    if (offset + size > sectionStart + sectionBytes) {
+        // This frame outgrew its section: double until it fits
+        GLsizeiptr bytes = sectionBytes;
+        while (bytes < used + size + alignment) bytes *= 2;
+        reallocate(bytes);
+        offset = 0;
+        sectionStart = 0;
+    }
+    used = offset + size - sectionStart;
+    return offset;
+}
+
+void StreamBuffer::upload(GLintptr offset, const void* data, GLsizeiptr size) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    void* dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                 GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst) {
+        std::memcpy(dst, data, size);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    } else {
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+
+    pendingBytes += size;
+    pendingWrites++;
+}
+
+GLintptr StreamBuffer::write(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+    GLintptr offset = allocate(size, alignment);
+    upload(offset, data, size);
+    return offset;
+}
+
+void StreamBuffer::endFrame() {
+    stats.frameBytes = pendingBytes;
+    stats.peakFrameBytes = std::max(stats.peakFrameBytes, pendingBytes);
+    stats.writes = pendingWrites;
+    pendingBytes = 0;
+    pendingWrites = 0;
+
+    // Idle frames keep their section
+    if (used == 0 || !buffer) return;
+    fences[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    section = (section + 1) % RING_SECTIONS;
+    used = 0;
+    sectionReady = false;
+}
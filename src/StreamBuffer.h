@@ -0,0 +1,65 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <glad/glad.h>
+
+// One vertex buffer that every per-frame upload (HUD vertices, particle,
+// item and viewmodel instances) is sub-allocated from. The buffer is a ring
+// of RING_SECTIONS frame sections: a frame appends linearly into its
+// section, endFrame() fences it, and a section is reused only once the GPU
+// has passed that fence (RING_SECTIONS frames later, so normally without
+// waiting). Writes go through an unsynchronised mapped range, or
+// glBufferSubData if mapping fails. Storage only grows when a frame
+// outgrows its section, and stats report bytes, stalls and growth.
+class StreamBuffer {
+public:
+    struct Stats {
+        GLsizeiptr frameBytes;      // written during the last finished frame
+        GLsizeiptr peakFrameBytes;
+        GLsizeiptr capacity;        // whole ring
+        int writes;                 // during the last finished frame
+        int stalls;                 // fence waits that weren't already signalled
+        int grows;                  // storage reallocations
+    };
+
+    StreamBuffer();
+    ~StreamBuffer();
+
+    void init(GLsizeiptr sectionBytes);
+    void cleanup();
+
+    // Copy size bytes into this frame's section and return their byte offset
+    // in getBuffer(), a multiple of alignment (use the vertex or instance
+    // stride, so offset / stride is a valid first vertex). Leaves the buffer
+    // bound to GL_ARRAY_BUFFER.
+    GLintptr write(const void* data, GLsizeiptr size, GLsizeiptr alignment);
+
+    // Reserve space for several blocks that must land in the same storage
+    // (a grow between separate writes would drop the earlier ones), then
+    // fill it piecewise with upload()
+    GLintptr allocate(GLsizeiptr size, GLsizeiptr alignment);
+    void upload(GLintptr offset, const void* data, GLsizeiptr size);
+
+    // Fence this frame's writes and move on to the next section
+    void endFrame();
+
+    unsigned int getBuffer() const { return buffer; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    static constexpr int RING_SECTIONS = 3;
+
+    unsigned int buffer;
+    GLsizeiptr sectionBytes;
+    int section;                    // section this frame writes
+    GLsizeiptr used;                // bytes of it written so far
+    bool sectionReady;              // its fence has been waited on
+    GLsync fences[RING_SECTIONS];
+    Stats stats;
+    GLsizeiptr pendingBytes;
+    int pendingWrites;
+
+    void reallocate(GLsizeiptr bytes);
+};
+
+#endif
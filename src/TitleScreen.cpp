@@ -1,4 +1,5 @@
 #include "TitleScreen.h"
+#include "Shader.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
@@ -7,6 +8,9 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// x, y, r, g, b, anim
+static const int FLOATS_PER_VERTEX = 6;
+
 // ── 5x7 pixel font for blocky Minecraft-style characters ──────────────────
 // Each character is a 5-wide x 7-tall bitmap stored as 7 bytes (1 bit per pixel).
 static const unsigned char FONT_5x7[][7] = {
@@ -89,13 +93,14 @@ static const unsigned char FONT_DIGITS[][7] = {
 };
 
 TitleScreen::TitleScreen()
-    : vao(0), vbo(0), shaderID(0)
+    : backgroundVAO(0), backgroundVBO(0), menuVAO(0), menuVBO(0)
+    , backgroundVertexCount(0), menuVertexCount(0), menuDirty(true)
     , menuIndex(0), inSettings(false)
     , selectedDifficulty(Difficulty::MEDIUM)
     , quitSelected(false)
     , prevUp(false), prevDown(false)
     , prevLeft(false), prevRight(false), prevEnter(false)
-    , bobTimer(0.0f)
+    , bobTimer(0.0f), pushAnim(ANIM_NONE)
 {
 }
 
@@ -104,13 +109,34 @@ TitleScreen::~TitleScreen() {
 }
 
 void TitleScreen::init() {
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
+    shader = std::make_unique<Shader>("shaders/title_vertex.glsl",
+                                      "shaders/hud_fragment.glsl");
+    glGenVertexArrays(1, &backgroundVAO);
+    glGenBuffers(1, &backgroundVBO);
+    glGenVertexArrays(1, &menuVAO);
+    glGenBuffers(1, &menuVBO);
+
+    std::vector<float> verts;
+    drawBackground(verts);
+    uploadLayer(backgroundVAO, backgroundVBO, verts, GL_STATIC_DRAW);
+    backgroundVertexCount = (int)(verts.size() / FLOATS_PER_VERTEX);
+    menuDirty = true;
 }
 
 void TitleScreen::cleanup() {
-    if (vao) { glDeleteVertexArrays(1, &vao); vao = 0; }
-    if (vbo) { glDeleteBuffers(1, &vbo); vbo = 0; }
+    if (backgroundVAO) { glDeleteVertexArrays(1, &backgroundVAO); backgroundVAO = 0; }
+    if (backgroundVBO) { glDeleteBuffers(1, &backgroundVBO); backgroundVBO = 0; }
+    if (menuVAO) { glDeleteVertexArrays(1, &menuVAO); menuVAO = 0; }
+    if (menuVBO) { glDeleteBuffers(1, &menuVBO); menuVBO = 0; }
+    shader.reset();
+}
+
+void TitleScreen::setHighscores(const std::vector<HighscoreEntry>& entries) {
+    bestStars.clear();
+    for (int d = 0; d < 4; d++)
+        bestStars.push_back(getBestStars(entries, d));
+    highscores.assign(entries.begin(), entries.begin() + std::min<size_t>(5, entries.size()));
+    menuDirty = true;
 }
 
 bool TitleScreen::update(float dt, bool upPressed, bool downPressed,
@@ -130,6 +156,12 @@ bool TitleScreen::update(float dt, bool upPressed, bool downPressed,
     prevRight = rightPressed;
     prevEnter = enterPressed;
 
+    // Any selection change invalidates the cached menu layer
+    int prevMenuIndex = menuIndex;
+    bool prevInSettings = inSettings;
+    Difficulty prevDifficulty = selectedDifficulty;
+    bool startGame = false;
+
     if (inSettings) {
         // Difficulty selection with left/right
         int d = (int)selectedDifficulty;
@@ -140,32 +172,35 @@ bool TitleScreen::update(float dt, bool upPressed, bool downPressed,
         if (enterEdge || upEdge || downEdge) {
             inSettings = false;  // back to main menu
         }
-        return false;
-    }
-
-    // Main menu navigation
-    if (upEdge) menuIndex = (menuIndex + 2) % 3;   // wrap up
-    if (downEdge) menuIndex = (menuIndex + 1) % 3;  // wrap down
-
-    if (enterEdge) {
-        switch (menuIndex) {
-            case 0: return true;  // New Game
-            case 1: inSettings = true; break;  // Settings
-            case 2: quitSelected = true; break; // Quit
+    } else {
+        // Main menu navigation
+        if (upEdge) menuIndex = (menuIndex + 2) % 3;   // wrap up
+        if (downEdge) menuIndex = (menuIndex + 1) % 3;  // wrap down
+
+        if (enterEdge) {
+            switch (menuIndex) {
+                case 0: startGame = true; break;    // New Game
+                case 1: inSettings = true; break;   // Settings
+                case 2: quitSelected = true; break; // Quit
+            }
         }
     }
 
-    return false;
+    if (menuIndex != prevMenuIndex || inSettings != prevInSettings ||
+        selectedDifficulty != prevDifficulty)
+        menuDirty = true;
+    return startGame;
 }
 
 void TitleScreen::pushQuad(std::vector<float>& v, float x0, float y0,
                            float x1, float y1, float r, float g, float b) {
-    v.insert(v.end(), {x0, y0, r, g, b});
-    v.insert(v.end(), {x1, y0, r, g, b});
-    v.insert(v.end(), {x1, y1, r, g, b});
-    v.insert(v.end(), {x0, y0, r, g, b});
-    v.insert(v.end(), {x1, y1, r, g, b});
-    v.insert(v.end(), {x0, y1, r, g, b});
+    float a = (float)pushAnim;
+    v.insert(v.end(), {x0, y0, r, g, b, a});
+    v.insert(v.end(), {x1, y0, r, g, b, a});
+    v.insert(v.end(), {x1, y1, r, g, b, a});
+    v.insert(v.end(), {x0, y0, r, g, b, a});
+    v.insert(v.end(), {x1, y1, r, g, b, a});
+    v.insert(v.end(), {x0, y1, r, g, b, a});
 }
 
 void TitleScreen::renderBlockChar(std::vector<float>& verts, float x, float y,
@@ -254,7 +289,7 @@ float TitleScreen::getTextWidth(const std::string& text, float pixelSize) const
     return text.size() * 6.0f * pixelSize - pixelSize; // last char has no spacing
 }
 
-void TitleScreen::drawBackground(std::vector<float>& verts, float time) {
+void TitleScreen::drawBackground(std::vector<float>& verts) {
     // Minecraft-style dirt/stone pattern background
     // Grid of slightly different colored blocks
     float blockSize = 0.08f;
@@ -302,19 +337,18 @@ void TitleScreen::drawBackground(std::vector<float>& verts, float time) {
         pushQuad(verts, -1.0f, vy, 1.0f, vy + 0.1f,
                  alpha * 0.02f, alpha * 0.01f, alpha * 0.03f);
     }
-    (void)time;
 }
 
-void TitleScreen::drawTitle(std::vector<float>& verts, float time) {
+void TitleScreen::drawTitle(std::vector<float>& verts) {
     // "MAZE RUNNER" in large blocky pixels
     float titlePixel = 0.016f;
     std::string title = "MAZE RUNNER";
     float titleWidth = getTextWidth(title, titlePixel);
 
-    // Gentle bob animation
-    float bob = std::sin(time * 1.5f) * 0.015f;
+    // Gentle bob animation (title_vertex.glsl)
+    pushAnim = ANIM_TITLE_BOB;
     float titleX = -titleWidth / 2.0f;
-    float titleY = 0.45f + bob;
+    float titleY = 0.45f;
 
     // Shadow/outline (render slightly offset in dark color)
     float shadowOff = titlePixel * 0.5f;
@@ -324,6 +358,7 @@ void TitleScreen::drawTitle(std::vector<float>& verts, float time) {
     // Main title in bright yellow (Minecraft title style)
     renderBlockText(verts, title, titleX, titleY,
                     titlePixel, 1.0f, 0.84f, 0.0f);
+    pushAnim = ANIM_NONE;
 
     // Subtitle
     std::string subtitle = "A MINECRAFT ADVENTURE";
@@ -333,57 +368,59 @@ void TitleScreen::drawTitle(std::vector<float>& verts, float time) {
                     subPixel, 0.7f, 0.7f, 0.7f);
 }
 
-void TitleScreen::drawMenu(std::vector<float>& verts, float time) {
+void TitleScreen::drawMenu(std::vector<float>& verts) {
     const char* items[] = {"NEW GAME", "SETTINGS", "QUIT"};
     float menuPixel = 0.008f;
     float startY = 0.05f;
     float spacing = 0.12f;
 
     for (int i = 0; i < 3; i++) {
-        float itemBob = 0.0f;
+        bool selected = (i == menuIndex && !inSettings);
         float r = 0.8f, g = 0.8f, b = 0.8f;
 
-        if (i == menuIndex && !inSettings) {
-            // Selected item: pulsing glow effect
-            float pulse = 0.7f + 0.3f * std::sin(time * 3.5f);
-            r = 1.0f * pulse; g = 1.0f * pulse; b = 0.3f * pulse;
-            itemBob = std::sin(time * 4.0f) * 0.005f;
+        if (selected) {
+            // Selected item: pulsing glow effect (pulse and bob are applied
+            // in title_vertex.glsl)
+            r = 1.0f; g = 1.0f; b = 0.3f;
 
             // Draw selection arrow (also pulses)
+            pushAnim = ANIM_MENU_PULSE;
             std::string arrow = ">";
             float arrowX = -0.35f;
-            float arrowY = startY - i * spacing + itemBob;
+            float arrowY = startY - i * spacing;
             renderBlockText(verts, arrow, arrowX, arrowY, menuPixel, r, g, b);
 
             // Glow background behind selected item
+            pushAnim = ANIM_MENU_GLOW;
             std::string text = items[i];
             float textWidth = getTextWidth(text, menuPixel);
-            float glowAlpha = 0.1f + 0.08f * std::sin(time * 3.5f);
             float glowPad = 0.02f;
             pushQuad(verts,
                      -textWidth / 2.0f - glowPad,
                      startY - i * spacing - 0.01f,
                      textWidth / 2.0f + glowPad,
                      startY - i * spacing + 7.0f * menuPixel + 0.01f,
-                     glowAlpha * 1.0f, glowAlpha * 0.8f, glowAlpha * 0.1f);
+                     1.0f, 0.8f, 0.1f);
         }
 
         std::string text = items[i];
         float textWidth = getTextWidth(text, menuPixel);
         float textX = -textWidth / 2.0f;
-        float textY = startY - i * spacing + itemBob;
+        float textY = startY - i * spacing;
 
         // Shadow
+        pushAnim = selected ? ANIM_MENU_BOB : ANIM_NONE;
         renderBlockText(verts, text, textX + menuPixel * 0.3f,
                         textY - menuPixel * 0.3f, menuPixel,
                         0.1f, 0.1f, 0.1f);
         // Main text
+        pushAnim = selected ? ANIM_MENU_PULSE : ANIM_NONE;
         renderBlockText(verts, text, textX, textY, menuPixel, r, g, b);
     }
+    pushAnim = ANIM_NONE;
 }
 
-void TitleScreen::drawDifficultySelector(std::vector<float>& verts, float time,
-                                         const std::vector<int>& bestStars) {
+void TitleScreen::drawDifficultySelector(std::vector<float>& verts) {
     if (!inSettings) return;
 
     // Dark overlay
@@ -416,15 +453,16 @@ void TitleScreen::drawDifficultySelector(std::vector<float>& verts, float time,
     std::string name = names[sel];
     float nameW = getTextWidth(name, namePixel);
 
-    float bob = std::sin(time * 3.0f) * 0.005f;
+    pushAnim = ANIM_SELECTOR_BOB;
 
     // Arrows
-    renderBlockText(verts, "<", -0.3f, 0.0f + bob, namePixel, 0.8f, 0.8f, 0.8f);
-    renderBlockText(verts, ">",  0.25f, 0.0f + bob, namePixel, 0.8f, 0.8f, 0.8f);
+    renderBlockText(verts, "<", -0.3f, 0.0f, namePixel, 0.8f, 0.8f, 0.8f);
+    renderBlockText(verts, ">",  0.25f, 0.0f, namePixel, 0.8f, 0.8f, 0.8f);
 
     // Difficulty name
-    renderBlockText(verts, name, -nameW / 2.0f, 0.0f + bob, namePixel,
+    renderBlockText(verts, name, -nameW / 2.0f, 0.0f, namePixel,
                     colors[sel][0], colors[sel][1], colors[sel][2]);
+    pushAnim = ANIM_NONE;
 
     // Show best stars for this difficulty
     if (sel < (int)bestStars.size()) {
@@ -448,25 +486,22 @@ void TitleScreen::drawDifficultySelector(std::vector<float>& verts, float time,
                     0.5f, 0.5f, 0.5f);
 }
 
-void TitleScreen::flush(const std::vector<float>& verts) {
-    if (verts.empty()) return;
-
+void TitleScreen::uploadLayer(unsigned int vao, unsigned int vbo,
+                              const std::vector<float>& verts, GLenum usage) {
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), usage);
+    GLsizei stride = FLOATS_PER_VERTEX * sizeof(float);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(2 * sizeof(float)));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
-
-    glDisable(GL_DEPTH_TEST);
-    glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-    glEnable(GL_DEPTH_TEST);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
     glBindVertexArray(0);
 }
 
-void TitleScreen::drawHighscores(std::vector<float>& verts, float time,
-                                  const std::vector<HighscoreEntry>& highscores) {
+void TitleScreen::drawHighscores(std::vector<float>& verts) {
     // Only show highscores on main menu, not in settings
     if (inSettings) return;
 
@@ -528,16 +563,13 @@ void TitleScreen::drawHighscores(std::vector<float>& verts, float time,
 }
 
 
-void TitleScreen::render(int /*screenWidth*/, int /*screenHeight*/, float time,
-                         const std::vector<int>& bestStars,
-                         const std::vector<HighscoreEntry>& highscores) {
+void TitleScreen::buildMenuLayer() {
     std::vector<float> verts;
 
-    drawBackground(verts, time);
-    drawTitle(verts, time);
-    drawMenu(verts, time);
-    drawDifficultySelector(verts, time, bestStars);
-    drawHighscores(verts, time, highscores);
+    drawTitle(verts);
+    drawMenu(verts);
+    drawDifficultySelector(verts);
+    drawHighscores(verts);
 
     // Instructions at bottom
     float instrPixel = 0.004f;
@@ -546,5 +578,23 @@ void TitleScreen::render(int /*screenWidth*/, int /*screenHeight*/, float time,
     renderBlockText(verts, instr, -instrW / 2.0f, -0.85f, instrPixel,
                     0.4f, 0.4f, 0.5f);
 
-    flush(verts);
+    uploadLayer(menuVAO, menuVBO, verts, GL_DYNAMIC_DRAW);
+    menuVertexCount = (int)(verts.size() / FLOATS_PER_VERTEX);
+    menuDirty = false;
+}
+
+void TitleScreen::render(int /*screenWidth*/, int /*screenHeight*/, float time) {
+    if (!shader) return;
+    if (menuDirty) buildMenuLayer();
+
+    shader->use();
+    shader->setFloat("time", time);
+
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(backgroundVAO);
+    glDrawArrays(GL_TRIANGLES, 0, backgroundVertexCount);
+    glBindVertexArray(menuVAO);
+    glDrawArrays(GL_TRIANGLES, 0, menuVertexCount);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
 }
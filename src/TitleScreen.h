@@ -3,6 +3,7 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <memory>
 #include <vector>
 #include <string>
 #include "StarRating.h"
@@ -15,6 +16,8 @@ enum class GameScreen {
     WIN_SCREEN
 };
 
+class Shader;
+
 // ── Title screen menu ──────────────────────────────────────────────────────
 class TitleScreen {
 public:
@@ -28,16 +31,37 @@ public:
     bool update(float dt, bool upPressed, bool downPressed,
                 bool leftPressed, bool rightPressed, bool enterPressed);
 
-    void render(int screenWidth, int screenHeight, float time,
-                const std::vector<int>& bestStars,
-                const std::vector<HighscoreEntry>& highscores);
+    // Highscores shown in the list and best stars per difficulty; call
+    // whenever they're (re)loaded
+    void setHighscores(const std::vector<HighscoreEntry>& entries);
+
+    // Draws the cached layers; only the time uniform changes per frame
+    void render(int screenWidth, int screenHeight, float time);
 
     Difficulty getSelectedDifficulty() const { return selectedDifficulty; }
     bool shouldQuit() const { return quitSelected; }
 
 private:
-    unsigned int vao, vbo;
-    unsigned int shaderID;
+    // Per-vertex animation, applied by title_vertex.glsl from the time uniform
+    enum Anim {
+        ANIM_NONE = 0,
+        ANIM_TITLE_BOB = 1,     // title and its shadow
+        ANIM_MENU_BOB = 2,      // selected menu item's shadow
+        ANIM_MENU_PULSE = 3,    // selected menu item and arrow: bob + pulse
+        ANIM_MENU_GLOW = 4,     // glow quad behind the selected item
+        ANIM_SELECTOR_BOB = 5   // difficulty name and arrows
+    };
+
+    // Background never changes: built once at init. Everything else is the
+    // menu layer, rebuilt only when the selection or highscores change.
+    unsigned int backgroundVAO, backgroundVBO;
+    unsigned int menuVAO, menuVBO;
+    int backgroundVertexCount, menuVertexCount;
+    bool menuDirty;
+    std::unique_ptr<Shader> shader;
+
+    std::vector<HighscoreEntry> highscores;   // top entries shown
+    std::vector<int> bestStars;               // per difficulty
 
     int menuIndex;           // 0 = New Game, 1 = Settings, 2 = Quit
     bool inSettings;         // sub-menu for difficulty
@@ -49,9 +73,7 @@ private:
 
     // Animation
     float bobTimer;
-
-    // Shader setup (uses HUD-style 2D rendering)
-    void compileShader();
+    Anim pushAnim;           // tag for the quads pushed next
 
     // Drawing helpers
     void pushQuad(std::vector<float>& v, float x0, float y0, float x1, float y1,
@@ -63,15 +85,15 @@ private:
                          float r, float g, float b);
     float getTextWidth(const std::string& text, float pixelSize) const;
 
-    void drawBackground(std::vector<float>& verts, float time);
-    void drawTitle(std::vector<float>& verts, float time);
-    void drawMenu(std::vector<float>& verts, float time);
-    void drawDifficultySelector(std::vector<float>& verts, float time,
-                                const std::vector<int>& bestStars);
-    void drawHighscores(std::vector<float>& verts, float time,
-                        const std::vector<HighscoreEntry>& highscores);
+    void drawBackground(std::vector<float>& verts);
+    void drawTitle(std::vector<float>& verts);
+    void drawMenu(std::vector<float>& verts);
+    void drawDifficultySelector(std::vector<float>& verts);
+    void drawHighscores(std::vector<float>& verts);
 
-    void flush(const std::vector<float>& verts);
+    void buildMenuLayer();
+    static void uploadLayer(unsigned int vao, unsigned int vbo,
+                            const std::vector<float>& verts, GLenum usage);
 };
 
 #endif
@@ -1,5 +1,6 @@
 #include "TorchLight.h"
 #include "Shader.h"
+#include "RenderQueue.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 
@@ -93,19 +94,17 @@ void TorchLight::buildGlowMesh() {
     glBindVertexArray(0);
 }
 
-void TorchLight::renderGlow(Shader& shader, const glm::mat4& view, const glm::mat4& projection) {
-    if (!enabled || !glowVAO) return;
+FrameUniforms::LightingBlock TorchLight::getGlowLighting(const FrameUniforms::LightingBlock& world) {
+    FrameUniforms::LightingBlock lighting = world;
+    lighting.fogDensity = 0.0f;
+    lighting.fogGradient = 1.0f;
+    lighting.sunColor = glm::vec3(1.0f);
+    lighting.ambientLevel = 1.0f;
+    return lighting;
+}
 
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
-    shader.setBool("useTexture", false);
-    shader.setFloat("fogDensity", 0.0f);
-    shader.setFloat("fogGradient", 1.0f);
-    shader.setBool("torchEnabled", false);
-    shader.setBool("enableEdgeOutline", false);
-    shader.setVec3("sunColor", glm::vec3(1.0f));
-    shader.setFloat("ambientLevel", 1.0f);
+void TorchLight::renderGlow(RenderQueue& queue, Shader& shader, const glm::mat4& view) {
+    if (!enabled || !glowVAO) return;
 
     // Billboard the glow sprite toward camera
     glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
@@ -122,11 +121,17 @@ void TorchLight::renderGlow(Shader& shader, const glm::mat4& view, const glm::ma
     float scale = 0.3f * flickerIntensity;
     model = glm::scale(model, glm::vec3(scale));
 
-    shader.setMat4("model", model);
-
-    glDisable(GL_CULL_FACE);
-    glBindVertexArray(glowVAO);
-    glDrawArrays(GL_TRIANGLES, 0, glowVertexCount);
-    glBindVertexArray(0);
-    glEnable(GL_CULL_FACE);
+    RenderQueue::Draw draw;
+    draw.pass = RenderQueue::PASS_GLOW;
+    draw.shader = &shader;
+    draw.vao = glowVAO;
+    draw.position = position;
+    draw.cullFace = false;
+    draw.owner = this;
+    draw.model = model;
+    draw.draw = [](const RenderQueue::Draw& d, Shader& glowShader, GLStateCache&) {
+        glowShader.setModel(d.model);
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<TorchLight*>(d.owner)->glowVertexCount);
+    };
+    queue.submit(draw);
 }
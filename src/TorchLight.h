@@ -1,11 +1,13 @@
 #ifndef TORCHLIGHT_H
 #define TORCHLIGHT_H
 
+#include "FrameUniforms.h"
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <vector>
 
 class Shader;
+class RenderQueue;
 
 class TorchLight {
 public:
@@ -26,8 +28,12 @@ public:
     // Update position based on player
     void setPlayerPosition(const glm::vec3& playerPos, const glm::vec3& playerFront);
 
-    // Render the torch glow sprite (small glowing quad)
-    void renderGlow(Shader& shader, const glm::mat4& view, const glm::mat4& projection);
+    // Queue the torch glow sprite (small glowing quad), billboarded toward
+    // the camera in view; the glow pass draws it with unlit lighting
+    void renderGlow(RenderQueue& queue, Shader& shader, const glm::mat4& view);
+
+    // Lighting for the glow: the world's, without fog, shading or torch
+    static FrameUniforms::LightingBlock getGlowLighting(const FrameUniforms::LightingBlock& world);
 
 private:
     bool enabled;
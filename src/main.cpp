@@ -4,19 +4,31 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Shader.h"
+#include "ShaderVariants.h"
 #include "Maze.h"
 #include "Player.h"
 #include "Renderer.h"
 
 #include "Collectible.h"
+#include "DynamicWalls.h"
+#include "Enemies.h"
+#include "Snapshot.h"
+#include "RewindBuffer.h"
 #include "StarRating.h"
 #include "Highscore.h"
 #include "TitleScreen.h"
 #include "HandRenderer.h"
 #include "SkyRenderer.h"
 #include "TorchLight.h"
+#include "HudBatch.h"
+#include "MinimapRenderer.h"
+#include "ParticleSystem.h"
+#include "FrameUniforms.h"
+#include "StreamBuffer.h"
+#include "RenderQueue.h"
 
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <cmath>
 #include <cstdio>
@@ -27,6 +39,13 @@
 static const float CELL_SIZE = 2.0f;
 static const float FIXED_DT  = 1.0f / 60.0f;
 static const std::string HIGHSCORE_FILE = "highscores.txt";
+static const std::string QUICKSAVE_FILE = "quicksave.bin";
+static const uint32_t SNAPSHOT_MAGIC   = 0x4E53524D;  // "MRSN"
+static const uint16_t SNAPSHOT_VERSION = 1;
+static const int WIN_PARTICLE_CAPACITY    = 256;
+static const int EFFECT_PARTICLE_CAPACITY = 1024;
+// One frame's section of the shared stream buffer; grows if outrun
+static const GLsizeiptr STREAM_SECTION_BYTES = 1 << 20;
 
 // ── Globals ────────────────────────────────────────────────────────────────
 static int screenWidth  = 1280;
@@ -38,9 +57,15 @@ static bool  firstMouse = true;
 
 static bool keyW = false, keyA = false, keyS = false, keyD = false;
 static bool keySpace = false;
+static bool keyBackspace = false;
 static bool requestRestart = false;
 static bool requestWireToggle = false;
 static bool requestTorchToggle = false;
+static bool requestQuickSave = false;
+static bool requestQuickLoad = false;
+static bool requestStatsToggle = false;
+static bool requestMazeModeToggle = false;
+static bool requestOverviewToggle = false;
 
 static Difficulty currentDifficulty = Difficulty::MEDIUM;
 static GameScreen currentScreen = GameScreen::TITLE_SCREEN;
@@ -51,123 +76,148 @@ static bool keyLeft = false, keyRight = false;
 static bool keyEnter = false;
 
 // ── HUD text rendering via bitmap quads ────────────────────────────────────
+// Everything goes into one HudBatch and is drawn by flush() once per frame.
 struct HudRenderer {
-    unsigned int vao = 0, vbo = 0;
-    Shader* shader = nullptr;
-
-    void init() {
-        glGenVertexArrays(1, &vao);
-        glGenBuffers(1, &vbo);
+    HudBatch batch;
+    std::vector<float> starScratch;   // StarRating.h helpers write x,y,r,g,b here
+
+    // Glyph quads, built once per character. Glyph strokes mix the cell's
+    // width and height, so each x edge is stored as (w, h) coefficients:
+    // x = penX + xw * charW + xh * charH; y = penY + y * charH.
+    struct GlyphQuad {
+        float x0w, x0h, x1w, x1h;
+        float y0, y1;
+    };
+    std::vector<GlyphQuad> glyphQuads;
+    int glyphFirst[128] = {}, glyphCount[128] = {};
+
+    // HUD text slots. Each keeps its expanded quads between frames and
+    // rebuilds them only when its text, placement, colour or the screen
+    // size changes, so a steady label is one copy into the batch.
+    enum Label {
+        LABEL_DELIVERED, LABEL_CARRY, LABEL_TIMER, LABEL_DIFFICULTY,
+        LABEL_WIN_TIME, LABEL_WIN_BOXES, LABEL_WIN_SCORE,
+        LABEL_STATS_VIS, LABEL_STATS_STREAM, LABEL_STATS_QUEUE,
+        LABEL_COUNT
+    };
+    struct CachedText {
+        std::string text;
+        float x = 0, y = 0, charW = 0, charH = 0, r = 0, g = 0, b = 0;
+        int scrW = 0, scrH = 0;
+        std::vector<HudBatch::Vertex> verts;
+    };
+    CachedText labels[LABEL_COUNT];
+
+    void init(StreamBuffer& stream) {
+        batch.init(stream);
+        buildGlyphs();
     }
 
     void cleanup() {
-        if (vao) { glDeleteVertexArrays(1, &vao); glDeleteBuffers(1, &vbo); }
+        batch.cleanup();
     }
 
-    void renderChar(std::vector<float>& verts, float x, float y, float w, float h,
-                    char c, float r, float g, float b) {
-        float t = h * 0.12f;
-        float hw = w * 0.8f;
-        float hh = h * 0.45f;
+    void buildGlyphs() {
+        const float t = 0.12f;     // stroke thickness (of h)
+        const float hw = 0.8f;     // glyph width (of w)
+        const float hh = 0.45f;    // half height (of h)
+        const float mid = hh, top = 2 * hh;
 
-        auto hSeg = [&](float sx, float sy) {
-            pushQuad(verts, sx, sy, sx + hw, sy + t, r, g, b);
-        };
-        auto vSeg = [&](float sx, float sy) {
-            pushQuad(verts, sx, sy, sx + t, sy + hh, r, g, b);
+        auto quad = [&](float x0w, float x0h, float x1w, float x1h, float y0, float y1) {
+            glyphQuads.push_back({x0w, x0h, x1w, x1h, y0, y1});
         };
-
-        float left = x;
-        float right = x + hw - t;
-        float bot = y;
-        float mid = y + hh;
-        float top = y + 2 * hh;
-
-        if (c >= '0' && c <= '9') {
-            bool segs[7] = {};
-            switch (c) {
-                case '0': segs[0]=segs[1]=segs[2]=segs[4]=segs[5]=segs[6]=true; break;
-                case '1': segs[2]=segs[5]=true; break;
-                case '2': segs[0]=segs[2]=segs[3]=segs[4]=segs[6]=true; break;
-                case '3': segs[0]=segs[2]=segs[3]=segs[5]=segs[6]=true; break;
-                case '4': segs[1]=segs[2]=segs[3]=segs[5]=true; break;
-                case '5': segs[0]=segs[1]=segs[3]=segs[5]=segs[6]=true; break;
-                case '6': segs[0]=segs[1]=segs[3]=segs[4]=segs[5]=segs[6]=true; break;
-                case '7': segs[0]=segs[2]=segs[5]=true; break;
-                case '8': segs[0]=segs[1]=segs[2]=segs[3]=segs[4]=segs[5]=segs[6]=true; break;
-                case '9': segs[0]=segs[1]=segs[2]=segs[3]=segs[5]=segs[6]=true; break;
-            }
-            if (segs[0]) hSeg(left, top);
-            if (segs[1]) vSeg(left, mid);
-            if (segs[2]) vSeg(right, mid);
-            if (segs[3]) hSeg(left, mid);
-            if (segs[4]) vSeg(left, bot);
-            if (segs[5]) vSeg(right, bot);
-            if (segs[6]) hSeg(left, bot);
-        } else if (c == ':') {
-            float dotSize = t * 1.5f;
-            float cx = x + hw * 0.4f;
-            pushQuad(verts, cx, mid + hh * 0.3f, cx + dotSize, mid + hh * 0.3f + dotSize, r, g, b);
-            pushQuad(verts, cx, bot + hh * 0.3f, cx + dotSize, bot + hh * 0.3f + dotSize, r, g, b);
-        } else if (c == '/') {
-            for (int i = 0; i < 5; i++) {
-                float fx = x + hw * 0.2f + (hw * 0.6f) * i / 5.0f;
-                float fy = bot + (top - bot) * i / 5.0f;
-                pushQuad(verts, fx, fy, fx + t, fy + t * 2, r, g, b);
+        // Horizontal and vertical seven-segment strokes; "right" is x + hw - t
+        auto hSeg = [&](float y) { quad(0.0f, 0.0f, hw, 0.0f, y, y + t); };
+        auto vSegL = [&](float y) { quad(0.0f, 0.0f, 0.0f, t, y, y + hh); };
+        auto vSegR = [&](float y) { quad(hw, -t, hw, 0.0f, y, y + hh); };
+
+        for (int c = 0; c < 128; c++) {
+            glyphFirst[c] = (int)glyphQuads.size();
+            if (c >= '0' && c <= '9') {
+                bool segs[7] = {};
+                switch (c) {
+                    case '0': segs[0]=segs[1]=segs[2]=segs[4]=segs[5]=segs[6]=true; break;
+                    case '1': segs[2]=segs[5]=true; break;
+                    case '2': segs[0]=segs[2]=segs[3]=segs[4]=segs[6]=true; break;
+                    case '3': segs[0]=segs[2]=segs[3]=segs[5]=segs[6]=true; break;
+                    case '4': segs[1]=segs[2]=segs[3]=segs[5]=true; break;
+                    case '5': segs[0]=segs[1]=segs[3]=segs[5]=segs[6]=true; break;
+                    case '6': segs[0]=segs[1]=segs[3]=segs[4]=segs[5]=segs[6]=true; break;
+                    case '7': segs[0]=segs[2]=segs[5]=true; break;
+                    case '8': segs[0]=segs[1]=segs[2]=segs[3]=segs[4]=segs[5]=segs[6]=true; break;
+                    case '9': segs[0]=segs[1]=segs[2]=segs[3]=segs[5]=segs[6]=true; break;
+                }
+                if (segs[0]) hSeg(top);
+                if (segs[1]) vSegL(mid);
+                if (segs[2]) vSegR(mid);
+                if (segs[3]) hSeg(mid);
+                if (segs[4]) vSegL(0.0f);
+                if (segs[5]) vSegR(0.0f);
+                if (segs[6]) hSeg(0.0f);
+            } else if (c == ':') {
+                float dotSize = t * 1.5f;
+                float cx = hw * 0.4f;
+                quad(cx, 0.0f, cx, dotSize, mid + hh * 0.3f, mid + hh * 0.3f + dotSize);
+                quad(cx, 0.0f, cx, dotSize, hh * 0.3f, hh * 0.3f + dotSize);
+            } else if (c == '/') {
+                for (int i = 0; i < 5; i++) {
+                    float fx = hw * 0.2f + (hw * 0.6f) * i / 5.0f;
+                    float fy = top * i / 5.0f;
+                    quad(fx, 0.0f, fx, t, fy, fy + t * 2);
+                }
+            } else if (c == ' ') {
+                // nothing
+            } else {
+                quad(0.0f, 0.0f, hw, 0.0f, 0.0f, top + t);
             }
-        } else if (c == ' ') {
-            // nothing
-        } else {
-            pushQuad(verts, x, bot, x + hw, top + t, r, g, b);
+            glyphCount[c] = (int)glyphQuads.size() - glyphFirst[c];
         }
     }
 
-    void pushQuad(std::vector<float>& v, float x0, float y0, float x1, float y1,
-                  float r, float g, float b) {
-        v.insert(v.end(), {x0,y0, r,g,b});
-        v.insert(v.end(), {x1,y0, r,g,b});
-        v.insert(v.end(), {x1,y1, r,g,b});
-        v.insert(v.end(), {x0,y0, r,g,b});
-        v.insert(v.end(), {x1,y1, r,g,b});
-        v.insert(v.end(), {x0,y1, r,g,b});
-    }
-
-    void renderText(Shader& hudShader, const std::string& text,
+    void renderText(Label label, const char* text,
                     float x, float y, float charW, float charH,
                     float r, float g, float b, int scrW, int scrH) {
-        std::vector<float> verts;
-        float ndcCharW = charW / scrW * 2.0f;
-        float ndcCharH = charH / scrH * 2.0f;
-        float ndcX = (x / scrW) * 2.0f - 1.0f;
-        float ndcY = (y / scrH) * 2.0f - 1.0f;
-
-        for (size_t i = 0; i < text.size(); i++) {
-            renderChar(verts, ndcX + i * ndcCharW * 1.2f, ndcY,
-                       ndcCharW, ndcCharH, text[i], r, g, b);
+        CachedText& cached = labels[label];
+        if (cached.text != text || cached.x != x || cached.y != y ||
+            cached.charW != charW || cached.charH != charH ||
+            cached.r != r || cached.g != g || cached.b != b ||
+            cached.scrW != scrW || cached.scrH != scrH) {
+            cached.text = text;
+            cached.x = x; cached.y = y; cached.charW = charW; cached.charH = charH;
+            cached.r = r; cached.g = g; cached.b = b;
+            cached.scrW = scrW; cached.scrH = scrH;
+            cached.verts.clear();
+            buildText(cached);
         }
+        batch.addVertices(cached.verts);
+    }
 
-        if (verts.empty()) return;
-
-        hudShader.use();
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        glDisable(GL_DEPTH_TEST);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-        glEnable(GL_DEPTH_TEST);
-        glBindVertexArray(0);
+    void buildText(CachedText& t) {
+        float ndcCharW = t.charW / t.scrW * 2.0f;
+        float ndcCharH = t.charH / t.scrH * 2.0f;
+        float ndcX = (t.x / t.scrW) * 2.0f - 1.0f;
+        float ndcY = (t.y / t.scrH) * 2.0f - 1.0f;
+
+        for (size_t i = 0; i < t.text.size(); i++) {
+            int c = (unsigned char)t.text[i] < 128 ? t.text[i] : '?';
+            float penX = ndcX + i * ndcCharW * 1.2f;
+            for (int q = glyphFirst[c]; q < glyphFirst[c] + glyphCount[c]; q++) {
+                const GlyphQuad& g0 = glyphQuads[q];
+                HudBatch::appendQuad(t.verts,
+                                     penX + g0.x0w * ndcCharW + g0.x0h * ndcCharH,
+                                     ndcY + g0.y0 * ndcCharH,
+                                     penX + g0.x1w * ndcCharW + g0.x1h * ndcCharH,
+                                     ndcY + g0.y1 * ndcCharH,
+                                     t.r, t.g, t.b);
+            }
+        }
     }
 
     // Render stars on the win screen (animated)
-    void renderWinStars(Shader& hudShader, int earnedStars, float winElapsed,
-                        std::vector<StarParticle>& particles,
+    void renderWinStars(int earnedStars, float winElapsed,
+                        ParticleSystem& particles,
                         int /*scrW*/, int scrH) {
-        std::vector<float> verts;
+        starScratch.clear();
 
         // Star positions: centered horizontally, above center
         const int totalStars = 5;
@@ -197,68 +247,35 @@ struct HudRenderer {
 
             // Spawn particles when star first appears
             if (timeSinceAppear < 0.017f) { // first frame
-                for (int p = 0; p < 12; p++) {
-                    float angle = p * 2.0f * (float)M_PI / 12.0f;
-                    StarParticle sp;
-                    sp.x = cx;
-                    sp.y = cy;
-                    sp.vx = cos(angle) * 0.3f;
-                    sp.vy = sin(angle) * 0.3f;
-                    sp.life = 0.5f;
-                    sp.maxLife = 0.5f;
-                    particles.push_back(sp);
-                }
+                particles.burst(glm::vec3(cx, cy, 0.0f), 12, 0.3f, 0.5f, 0.005f,
+                                glm::vec3(1.0f, 0.843f, 0.0f));
             }
 
             bool earned = (i < earnedStars);
 
             if (earned) {
                 // Bright yellow #FFD700
-                generateStarVerts(verts, cx, cy, outerR, innerR,
+                generateStarVerts(starScratch, cx, cy, outerR, innerR,
                                   1.0f, 0.843f, 0.0f, scale);
                 // White outline
-                generateStarOutline(verts, cx, cy, outerR, innerR,
+                generateStarOutline(starScratch, cx, cy, outerR, innerR,
                                     1.0f, 1.0f, 1.0f, scale);
             } else {
                 // Dark gray #444444
-                generateStarVerts(verts, cx, cy, outerR, innerR,
+                generateStarVerts(starScratch, cx, cy, outerR, innerR,
                                   0.267f, 0.267f, 0.267f, scale);
                 // Dim gray outline
-                generateStarOutline(verts, cx, cy, outerR, innerR,
+                generateStarOutline(starScratch, cx, cy, outerR, innerR,
                                     0.4f, 0.4f, 0.4f, scale);
             }
         }
-
-        // Render particles
-        for (auto& p : particles) {
-            if (p.life <= 0.0f) continue;
-            float alpha = p.life / p.maxLife;
-            float pSize = 0.005f * alpha;
-            pushQuad(verts, p.x - pSize, p.y - pSize, p.x + pSize, p.y + pSize,
-                     1.0f * alpha, 0.843f * alpha, 0.0f);
-        }
-
-        if (verts.empty()) return;
-
-        hudShader.use();
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        glDisable(GL_DEPTH_TEST);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-        glEnable(GL_DEPTH_TEST);
-        glBindVertexArray(0);
+        batch.addTriangles(starScratch);
     }
 
     // Render small inline stars for highscore/preview
-    void renderSmallStars(Shader& hudShader, float x, float y, int earned, int total,
+    void renderSmallStars(float x, float y, int earned, int total,
                           int scrW, int scrH) {
-        std::vector<float> verts;
+        starScratch.clear();
 
         float outerR = 8.0f / scrH * 2.0f;
         float innerR = 3.5f / scrH * 2.0f;
@@ -273,185 +290,20 @@ struct HudRenderer {
 
             if (i < earned) {
                 // Gold #FFD700
-                generateStarVerts(verts, cx, cy, outerR, innerR,
+                generateStarVerts(starScratch, cx, cy, outerR, innerR,
                                   1.0f, 0.843f, 0.0f);
             } else {
                 // Dark gray #444444
-                generateStarVerts(verts, cx, cy, outerR, innerR,
+                generateStarVerts(starScratch, cx, cy, outerR, innerR,
                                   0.267f, 0.267f, 0.267f);
             }
         }
-
-        if (verts.empty()) return;
-
-        hudShader.use();
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        glDisable(GL_DEPTH_TEST);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-        glEnable(GL_DEPTH_TEST);
-        glBindVertexArray(0);
+        batch.addTriangles(starScratch);
     }
 
-    void renderMinimap(Shader& hudShader, const Maze& maze,
-                       const glm::vec3& playerPos, float playerYaw,
-                       const glm::vec3& exitWorldPos,
-                       int scrW, int scrH) {
-        float marginPx = 20.0f;
-        float radiusPx = 90.0f;
-        float cellPixelSize = 12.0f;
-        int viewRadiusCells = (int)std::floor(radiusPx / cellPixelSize);
-
-        float centerPxX = scrW - radiusPx - marginPx;
-        float centerPxY = scrH - radiusPx - marginPx;
-
-        auto pushQuadPx = [&](std::vector<float>& v, float x0, float y0, float x1, float y1,
-                              float r, float g, float b) {
-            float ndcX0 = (x0 / scrW) * 2.0f - 1.0f;
-            float ndcX1 = (x1 / scrW) * 2.0f - 1.0f;
-            float ndcY0 = (y0 / scrH) * 2.0f - 1.0f;
-            float ndcY1 = (y1 / scrH) * 2.0f - 1.0f;
-            pushQuad(v, ndcX0, ndcY0, ndcX1, ndcY1, r, g, b);
-        };
-
-        auto toNdc = [&](float px, float py) {
-            float ndcX = (px / scrW) * 2.0f - 1.0f;
-            float ndcY = (py / scrH) * 2.0f - 1.0f;
-            return std::pair<float,float>(ndcX, ndcY);
-        };
-
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_STENCIL_TEST);
-        glStencilMask(0xFF);
-        glClearStencil(0);
-        glClear(GL_STENCIL_BUFFER_BIT);
-
-        // Circle mask / background
-        std::vector<float> verts;
-        const int circleSegments = 48;
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glStencilOp(GL_REPLACE, GL_REPLACE, GL_REPLACE);
-        float cxPx = centerPxX;
-        float cyPx = centerPxY;
-        for (int i = 0; i < circleSegments; i++) {
-            float a0 = (float)i / circleSegments * 2.0f * M_PI;
-            float a1 = (float)(i + 1) / circleSegments * 2.0f * M_PI;
-            float x0 = cxPx + std::cos(a0) * radiusPx;
-            float y0 = cyPx + std::sin(a0) * radiusPx;
-            float x1 = cxPx + std::cos(a1) * radiusPx;
-            float y1 = cyPx + std::sin(a1) * radiusPx;
-
-            auto [ndcCx, ndcCy] = toNdc(cxPx, cyPx);
-            auto [ndcX0, ndcY0] = toNdc(x0, y0);
-            auto [ndcX1, ndcY1] = toNdc(x1, y1);
-
-            verts.insert(verts.end(), {
-                ndcCx, ndcCy, 0.05f, 0.05f, 0.08f,
-                ndcX0, ndcY0, 0.05f, 0.05f, 0.08f,
-                ndcX1, ndcY1, 0.05f, 0.05f, 0.08f
-            });
-        }
-
-        hudShader.use();
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void*)(2*sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-
-        // Map content clipped to circle
-        glStencilMask(0x00);
-        glStencilFunc(GL_EQUAL, 1, 0xFF);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
-
-        verts.clear();
-
-        float playerCellX = playerPos.x / CELL_SIZE;
-        float playerCellY = playerPos.z / CELL_SIZE;
-        int centerCellX = (int)std::floor(playerCellX);
-        int centerCellY = (int)std::floor(playerCellY);
-
-        for (int dy = -viewRadiusCells; dy <= viewRadiusCells; dy++) {
-            int cy = centerCellY + dy;
-            if (cy < 0 || cy >= maze.getHeight()) continue;
-            for (int dx = -viewRadiusCells; dx <= viewRadiusCells; dx++) {
-                int cx = centerCellX + dx;
-                if (cx < 0 || cx >= maze.getWidth()) continue;
-
-                bool wall = maze.isWall(cx, cy);
-                float intensity = wall ? 0.25f : 0.55f;
-
-                float px = centerPxX + dx * cellPixelSize;
-                float py = centerPxY - dy * cellPixelSize;
-                float half = cellPixelSize * 0.45f;
-                pushQuadPx(verts,
-                           px - half, py - half,
-                           px + half, py + half,
-                           intensity, intensity, intensity + (wall ? 0.0f : 0.1f));
-            }
-        }
-
-        // Exit marker (only if within view)
-        float exitCellX = exitWorldPos.x / CELL_SIZE;
-        float exitCellY = exitWorldPos.z / CELL_SIZE;
-        float exitDx = exitCellX - playerCellX;
-        float exitDy = exitCellY - playerCellY;
-        if (std::abs(exitDx) <= viewRadiusCells + 0.5f &&
-            std::abs(exitDy) <= viewRadiusCells + 0.5f) {
-            float px = centerPxX + exitDx * cellPixelSize;
-            float py = centerPxY - exitDy * cellPixelSize;
-            float half = cellPixelSize * 0.35f;
-            pushQuadPx(verts,
-                       px - half, py - half,
-                       px + half, py + half,
-                       0.9f, 0.6f, 0.1f);
-        }
-
-        if (!verts.empty()) {
-            glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-            glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-        }
-
-        // Player arrow (north-up; yaw rotates arrow only)
-        glm::vec2 dir = glm::normalize(glm::vec2(std::cos(glm::radians(playerYaw)),
-                                                 -std::sin(glm::radians(playerYaw))));
-        glm::vec2 perp(-dir.y, dir.x);
-        float arrowLen = 12.0f;
-        float arrowWidth = 6.0f;
-        glm::vec2 tip = dir * arrowLen;
-        glm::vec2 left = -dir * (arrowLen * 0.4f) + perp * arrowWidth;
-        glm::vec2 right = -dir * (arrowLen * 0.4f) - perp * arrowWidth;
-
-        float basePxX = centerPxX;
-        float basePxY = centerPxY;
-
-        auto [ndcTipX, ndcTipY] = toNdc(basePxX + tip.x, basePxY + tip.y);
-        auto [ndcLeftX, ndcLeftY] = toNdc(basePxX + left.x, basePxY + left.y);
-        auto [ndcRightX, ndcRightY] = toNdc(basePxX + right.x, basePxY + right.y);
-
-        float arrowColor[3] = {0.2f, 0.9f, 0.7f};
-        verts = {
-            ndcTipX, ndcTipY, arrowColor[0], arrowColor[1], arrowColor[2],
-            ndcLeftX, ndcLeftY, arrowColor[0], arrowColor[1], arrowColor[2],
-            ndcRightX, ndcRightY, arrowColor[0], arrowColor[1], arrowColor[2],
-        };
-
-        glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLES, 0, (int)(verts.size() / 5));
-
-        glStencilMask(0xFF);
-        glDisable(GL_STENCIL_TEST);
-        glEnable(GL_DEPTH_TEST);
-        glBindVertexArray(0);
+    // Draw everything queued this frame
+    void flush(Shader& hudShader) {
+        batch.flush(hudShader);
     }
 };
 
@@ -510,6 +362,12 @@ static void keyCallback(GLFWwindow* window, int key, int /*scancode*/, int actio
         case GLFW_KEY_R:  if (down) requestRestart = true; break;
         case GLFW_KEY_F1: if (down) requestWireToggle = true; break;
         case GLFW_KEY_T:  if (down) requestTorchToggle = true; break;
+        case GLFW_KEY_M:  if (down) requestOverviewToggle = true; break;
+        case GLFW_KEY_F2: if (down) requestMazeModeToggle = true; break;
+        case GLFW_KEY_F3: if (down) requestStatsToggle = true; break;
+        case GLFW_KEY_F5: if (down) requestQuickSave = true; break;
+        case GLFW_KEY_F9: if (down) requestQuickLoad = true; break;
+        case GLFW_KEY_BACKSPACE: keyBackspace = pressed; break;
         case GLFW_KEY_ESCAPE:
             if (currentScreen == GameScreen::PLAYING) {
                 currentScreen = GameScreen::TITLE_SCREEN;
@@ -526,7 +384,10 @@ struct GameState {
     Maze maze;
     Player player;
     Renderer renderer;
+    MinimapRenderer minimap;
     Collectible collectibles;
+    DynamicWalls dynamicWalls;
+    Enemies enemies;
     glm::vec3 exitWorldPos;
     float elapsedTime;
     bool won;
@@ -537,30 +398,46 @@ struct GameState {
     // Win screen state
     float winScreenStartTime;
     StarResult starResult;
-    std::vector<StarParticle> winParticles;
+    ParticleSystem winParticles;   // star bursts, NDC
+    ParticleSystem effects;        // pickup/delivery sparks, world space
     bool scoreSaved;
 
+    // Snapshots: per-tick rewind history and an in-memory quick save
+    RewindBuffer rewind;
+    std::vector<uint8_t> snapshotScratch;
+    std::vector<uint8_t> quickSave;
+    bool practiceRun;  // rewound or quick-loaded: no highscore
+
+    // Carried indices collected by loadSnapshot()'s validation pass
+    std::vector<int> carriedScratch;
+
     GameState(Difficulty diff)
         : maze(getDifficultyConfig(diff).mazeWidth, getDifficultyConfig(diff).mazeHeight),
           elapsedTime(0), won(false), wireframe(false), difficulty(diff),
           boxesDelivered(0),
-          winScreenStartTime(0), scoreSaved(false)
+          winScreenStartTime(0),
+          winParticles(ParticleSystem::SCREEN, WIN_PARTICLE_CAPACITY),
+          effects(ParticleSystem::WORLD, EFFECT_PARTICLE_CAPACITY),
+          scoreSaved(false), practiceRun(false)
     {
         starResult.stars = 0;
         starResult.perfectRun = false;
     }
 
-    void restart(Difficulty diff) {
+    // seed 0 picks a fresh random maze
+    void restart(Difficulty diff, unsigned int seed = 0) {
         difficulty = diff;
         auto cfg = getDifficultyConfig(diff);
 
-        maze = Maze(cfg.mazeWidth, cfg.mazeHeight);
+        maze = Maze(cfg.mazeWidth, cfg.mazeHeight, seed);
         maze.generate();
+        dynamicWalls.generate(maze);
 
         auto [sx, sy] = maze.getStart();
         player.init((float)sx, (float)sy);
 
         renderer.buildMazeMesh(maze);
+        minimap.setMaze(maze);
 
         auto [ex, ey] = maze.getExit();
         exitWorldPos = glm::vec3(ex * CELL_SIZE + CELL_SIZE * 0.5f,
@@ -569,6 +446,7 @@ struct GameState {
 
         auto positions = maze.getItemPositions(cfg.numItems);
         collectibles.placeItems(positions);
+        enemies.spawn(maze, cfg.numEnemies);
 
         elapsedTime = 0.0f;
         won = false;
@@ -577,7 +455,105 @@ struct GameState {
         starResult.stars = 0;
         starResult.perfectRun = false;
         winParticles.clear();
+        effects.clear();
         scoreSaved = false;
+        rewind.clear();
+        practiceRun = false;
+    }
+
+    // Compact binary snapshot of the running game. The maze is referenced
+    // by difficulty + seed; item positions and door layout regenerate from it.
+    void saveSnapshot(std::vector<uint8_t>& out) const {
+        out.clear();
+        SnapshotWriter writer(out);
+        writer.write(SNAPSHOT_MAGIC);
+        writer.write(SNAPSHOT_VERSION);
+        writer.write((uint8_t)difficulty);
+        writer.write(maze.getSeed());
+        writer.write(elapsedTime);
+        writer.write(boxesDelivered);
+        player.writeState(writer);
+        collectibles.writeState(writer);
+        dynamicWalls.writeState(writer);
+        enemies.writeState(writer);
+    }
+
+    // Restore a snapshot from saveSnapshot(). A different maze is regenerated
+    // from its seed first. Returns false on malformed data, in which case the
+    // running game is left as it was.
+    bool loadSnapshot(const std::vector<uint8_t>& data) {
+        SnapshotReader reader(data.data(), data.size());
+        uint32_t magic = 0;
+        uint16_t version = 0;
+        uint8_t diff = 0;
+        unsigned int seed = 0;
+        reader.read(magic);
+        reader.read(version);
+        reader.read(diff);
+        reader.read(seed);
+        if (!reader.good() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+            diff > (uint8_t)Difficulty::NIGHTMARE)
+            return false;
+
+        // Validate the rest of the payload against the world it applies to
+        // before touching anything. For the running maze that is the live
+        // state itself; another maze is generated aside just for the check.
+        size_t headerSize = data.size() - reader.remaining();
+        bool newMaze = (Difficulty)diff != difficulty || seed != maze.getSeed();
+        if (newMaze) {
+            auto cfg = getDifficultyConfig((Difficulty)diff);
+            Maze otherMaze(cfg.mazeWidth, cfg.mazeHeight, seed);
+            otherMaze.generate();
+            DynamicWalls otherWalls;
+            Collectible otherItems;
+            Enemies otherEnemies;
+            otherWalls.generate(otherMaze);
+            otherItems.placeItems(otherMaze.getItemPositions(cfg.numItems));
+            otherEnemies.spawn(otherMaze, cfg.numEnemies);
+            if (!checkPayload(reader, otherItems, otherWalls, otherEnemies)) return false;
+        } else if (!checkPayload(reader, collectibles, dynamicWalls, enemies)) {
+            return false;
+        }
+
+        // Everything checked out: read straight into the live game
+        if (newMaze) restart((Difficulty)diff, seed);
+        SnapshotReader body(data.data() + headerSize, data.size() - headerSize);
+        float time = 0.0f;
+        int delivered = 0;
+        body.read(time);
+        body.read(delivered);
+        player.readState(body);
+        collectibles.readState(body);
+        dynamicWalls.readState(body, maze);
+        enemies.readState(body, maze, player.position);
+        elapsedTime = time;
+        boxesDelivered = delivered;
+
+        // Door/gate changes go through the same incremental paths as gameplay
+        if (!dynamicWalls.getChangedCells().empty()) {
+            renderer.updateMazeCells(maze, dynamicWalls.getChangedCells());
+            minimap.updateCells(maze, dynamicWalls.getChangedCells());
+            enemies.onWallsChanged(maze, dynamicWalls.getChangedCells());
+            dynamicWalls.clearChanges();
+        }
+
+        won = false;
+        winParticles.clear();
+        effects.clear();
+        scoreSaved = false;
+        return true;
+    }
+
+    // Dry run over the snapshot body (after the header) against a world of
+    // the right maze; nothing is modified
+    bool checkPayload(SnapshotReader& reader, const Collectible& items,
+                      const DynamicWalls& walls, const Enemies& foes) {
+        int delivered = 0;
+        reader.skip(sizeof(float));   // elapsed time
+        reader.read(delivered);
+        return Player::checkState(reader, carriedScratch) &&
+               items.checkState(reader, carriedScratch, delivered) &&
+               walls.checkState(reader) && foes.checkState(reader);
     }
 };
 
@@ -621,24 +597,61 @@ int main() {
     glCullFace(GL_BACK);
 
     // Load shaders
-    Shader mainShader("shaders/vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants mainShaders("shaders/vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants mazeShaders("shaders/maze_vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants mazeGridShaders("shaders/maze_grid_vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants itemShaders("shaders/item_vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants enemyShaders("shaders/enemy_vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants exitShaders("shaders/exit_vertex.glsl", "shaders/fragment.glsl");
+    ShaderVariants viewmodelShaders("shaders/viewmodel_vertex.glsl", "shaders/fragment.glsl");
     Shader hudShader("shaders/hud_vertex.glsl", "shaders/hud_fragment.glsl");
+    Shader particleShader("shaders/particle_vertex.glsl", "shaders/hud_fragment.glsl",
+                          FrameUniforms::GLSL_BLOCKS);
+
+    // Every variant the game draws with, with and without the torch, so
+    // toggling it never compiles mid-game
+    const unsigned TEX = ShaderVariants::TEXTURE, TORCH = ShaderVariants::TORCH;
+    const unsigned MAZE = TEX | ShaderVariants::EDGE_OUTLINE;
+    const unsigned DECAL = TEX | ShaderVariants::ALPHA_TEST | ShaderVariants::STATIC;
+    mainShaders.warm({0, DECAL, DECAL | TORCH});
+    mazeShaders.warm({MAZE, MAZE | TORCH});
+    mazeGridShaders.warm({MAZE, MAZE | TORCH});
+    itemShaders.warm({TEX, TEX | TORCH});
+    enemyShaders.warm({0, TORCH});
+    exitShaders.warm({0, TORCH});
+    viewmodelShaders.warm({TEX, TEX | TORCH});
+
+    // Camera and lighting shared by every 3D program, uploaded once per frame
+    FrameUniforms frameUniforms;
+    frameUniforms.init();
+    FrameUniforms::attach(particleShader.ID);
+
+    // Every per-frame vertex and instance upload shares this ring
+    StreamBuffer streamBuffer;
+    streamBuffer.init(STREAM_SECTION_BYTES);
+
+    // Scene draws are recorded, sorted by state and submitted once per frame
+    RenderQueue renderQueue;
 
     // Initialize game
     GameState game(currentDifficulty);
-    game.renderer.init();
+    game.renderer.init(streamBuffer);
+    game.minimap.init();
+    game.winParticles.init(streamBuffer);
+    game.effects.init(streamBuffer);
+    game.effects.setGravity(6.0f);
     game.restart(currentDifficulty);
 
     g_player = &game.player;
 
     HudRenderer hud;
-    hud.init();
+    hud.init(streamBuffer);
 
     TitleScreen titleScreen;
     titleScreen.init();
 
     HandRenderer handRenderer;
-    handRenderer.init();
+    handRenderer.init(streamBuffer);
 
     SkyRenderer skyRenderer;
     skyRenderer.init();
@@ -648,8 +661,14 @@ int main() {
 
     // Load highscores for star preview
     auto highscores = loadHighscores(HIGHSCORE_FILE);
+    titleScreen.setHighscores(highscores);
 
     float accumulator = 0.0f;
+    bool showStats = false;   // F3
+    float statsTimer = 0.0f;
+    char statsVis[96] = "";   // HUD stats lines, refreshed once per second
+    char statsStream[96] = "";
+    char statsQueue[96] = "";
     float lastTime = (float)glfwGetTime();
 
     // ── Main loop ──────────────────────────────────────────────────────────
@@ -678,6 +697,7 @@ int main() {
                 currentDifficulty = titleScreen.getSelectedDifficulty();
                 game.restart(currentDifficulty);
                 highscores = loadHighscores(HIGHSCORE_FILE);
+                titleScreen.setHighscores(highscores);
                 currentScreen = GameScreen::PLAYING;
                 firstMouse = true;
                 glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -688,15 +708,10 @@ int main() {
             glClearColor(0.05f, 0.05f, 0.08f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            // Get best stars for each difficulty
-            std::vector<int> bestStars;
-            for (int d = 0; d < 4; d++) {
-                bestStars.push_back(getBestStars(highscores, d));
-            }
-
-            hudShader.use();
-            titleScreen.render(screenWidth, screenHeight, currentTime, bestStars, highscores);
+            titleScreen.render(screenWidth, screenHeight, currentTime);
 
+            streamBuffer.endFrame();
+            renderQueue.endFrame();
             glfwSwapBuffers(window);
             glfwPollEvents();
             continue;
@@ -708,6 +723,7 @@ int main() {
         if (requestRestart) {
             game.restart(currentDifficulty);
             highscores = loadHighscores(HIGHSCORE_FILE);
+            titleScreen.setHighscores(highscores);
             requestRestart = false;
         }
         if (requestWireToggle) {
@@ -719,17 +735,89 @@ int main() {
             torchLight.toggle();
             requestTorchToggle = false;
         }
+        if (requestMazeModeToggle) {
+            bool grid = game.renderer.getMazeRenderMode() == MazeRenderMode::GRID;
+            game.renderer.setMazeRenderMode(grid ? MazeRenderMode::MESH : MazeRenderMode::GRID,
+                                            game.maze);
+            requestMazeModeToggle = false;
+        }
+        if (requestStatsToggle) {
+            showStats = !showStats;
+            statsTimer = 0.0f;
+            requestStatsToggle = false;
+        }
+        if (requestOverviewToggle) {
+            game.minimap.toggleOverview();
+            requestOverviewToggle = false;
+        }
+        if (requestQuickSave) {
+            game.saveSnapshot(game.quickSave);
+            std::ofstream file(QUICKSAVE_FILE, std::ios::binary);
+            file.write((const char*)game.quickSave.data(), game.quickSave.size());
+            if (!file) std::cerr << "Failed to write " << QUICKSAVE_FILE << std::endl;
+            requestQuickSave = false;
+        }
+        if (requestQuickLoad) {
+            if (game.quickSave.empty()) {
+                std::ifstream file(QUICKSAVE_FILE, std::ios::binary);
+                game.quickSave.assign(std::istreambuf_iterator<char>(file),
+                                      std::istreambuf_iterator<char>());
+            }
+            if (!game.quickSave.empty() && game.loadSnapshot(game.quickSave)) {
+                game.rewind.clear();
+                game.practiceRun = true;
+                accumulator = 0.0f;
+            } else {
+                std::cerr << "No valid quick save to load" << std::endl;
+            }
+            requestQuickLoad = false;
+        }
 
         // Fixed timestep physics
         if (!game.won) {
             accumulator += frameTime;
             while (accumulator >= FIXED_DT) {
+                // Holding Backspace replays recorded ticks backwards
+                if (keyBackspace) {
+                    if (game.rewind.stepBack(game.snapshotScratch) &&
+                        game.loadSnapshot(game.snapshotScratch))
+                        game.practiceRun = true;
+                    accumulator -= FIXED_DT;
+                    continue;
+                }
+
                 game.player.update(FIXED_DT, game.maze,
                                    keyW, keyS, keyA, keyD, keySpace);
                 game.collectibles.update(FIXED_DT);
+
+                bool carryingKey = false;
+                for (int idx : game.player.carriedItems)
+                    if (game.collectibles.getType(idx) == ItemType::KEY) carryingKey = true;
+                game.dynamicWalls.update(FIXED_DT, game.maze, game.player.position, carryingKey);
+
+                // Remesh only the chunks around doors/gates that changed and
+                // repair the enemies' flow field in place
+                if (!game.dynamicWalls.getChangedCells().empty()) {
+                    game.renderer.updateMazeCells(game.maze, game.dynamicWalls.getChangedCells());
+                    game.minimap.updateCells(game.maze, game.dynamicWalls.getChangedCells());
+                    game.enemies.onWallsChanged(game.maze, game.dynamicWalls.getChangedCells());
+                    game.dynamicWalls.clearChanges();
+                }
+
+                // Caught: carried items drop back to their spots, player respawns
+                if (game.enemies.update(FIXED_DT, game.maze, game.player.position)) {
+                    for (int idx : game.player.carriedItems)
+                        game.collectibles.returnToWorld(idx);
+                    game.player.carriedItems.clear();
+                    auto [sx, sy] = game.maze.getStart();
+                    game.player.init((float)sx, (float)sy);
+                }
+
+                game.saveSnapshot(game.snapshotScratch);
+                game.rewind.push(game.snapshotScratch);
                 accumulator -= FIXED_DT;
             }
-            game.elapsedTime += frameTime;
+            if (!keyBackspace) game.elapsedTime += frameTime;
         }
 
         // Update sky and torch
@@ -742,6 +830,8 @@ int main() {
             int idx = game.collectibles.tryPickup(game.player.position, false);
             if (idx >= 0) {
                 game.player.carriedItems.push_back(idx);
+                game.effects.burst(game.collectibles.getPosition(idx), 16, 1.2f, 0.6f, 0.05f,
+                                   glm::vec3(1.0f, 0.8f, 0.3f));
             }
         }
 
@@ -752,15 +842,12 @@ int main() {
         if (inExitZone && !game.player.carriedItems.empty()) {
             // Count delivered boxes
             game.boxesDelivered += (int)game.player.carriedItems.size();
+            game.effects.burst(game.exitWorldPos, 24 * (int)game.player.carriedItems.size(),
+                               2.0f, 1.0f, 0.08f, glm::vec3(1.0f, 0.84f, 0.0f));
 
             // Mark items as collected (delivered)
-            auto& items = game.collectibles.getItemsMut();
-            for (int idx : game.player.carriedItems) {
-                if (idx >= 0 && idx < (int)items.size()) {
-                    items[idx].pickedUp  = false;
-                    items[idx].collected = true;
-                }
-            }
+            for (int idx : game.player.carriedItems)
+                game.collectibles.deposit(idx);
             game.player.carriedItems.clear();
         }
 
@@ -779,7 +866,7 @@ int main() {
                                              totalCollectables);
 
             // Save highscore
-            if (!game.scoreSaved) {
+            if (!game.scoreSaved && !game.practiceRun) {
                 HighscoreEntry entry;
                 entry.name = "Player";
                 // New scoring: base score on delivered boxes count
@@ -791,23 +878,14 @@ int main() {
                 entry.perfectRun = game.starResult.perfectRun ? 1 : 0;
                 addHighscore(HIGHSCORE_FILE, entry);
                 highscores = loadHighscores(HIGHSCORE_FILE);
+                titleScreen.setHighscores(highscores);
                 game.scoreSaved = true;
             }
         }
 
-        // Update win screen particles
-        if (game.won) {
-            for (auto& p : game.winParticles) {
-                p.x += p.vx * frameTime;
-                p.y += p.vy * frameTime;
-                p.life -= frameTime;
-            }
-            // Remove dead particles
-            game.winParticles.erase(
-                std::remove_if(game.winParticles.begin(), game.winParticles.end(),
-                               [](const StarParticle& p) { return p.life <= 0.0f; }),
-                game.winParticles.end());
-        }
+        // Update particles (fixed pools: dead ones are swapped out in place)
+        game.effects.update(frameTime);
+        if (game.won) game.winParticles.update(frameTime);
 
         // ── Render ─────────────────────────────────────────────────────────
         glm::vec3 fogCol = skyRenderer.getFogColor();
@@ -818,68 +896,105 @@ int main() {
         glm::mat4 projection = glm::perspective(
             glm::radians(70.0f), aspect, 0.1f, 200.0f);
         glm::mat4 view = game.player.getViewMatrix();
+        game.renderer.updateVisibility(game.maze, game.player.position,
+                                       game.player.getFront(), projection);
+
+        // Performance stats for the HUD, sampled once per second while
+        // enabled; times are in microseconds since the HUD font has no '.'
+        if (showStats && (statsTimer -= frameTime) <= 0.0f) {
+            const GridVisibility& vis = game.renderer.getVisibility();
+            std::snprintf(statsVis, sizeof(statsVis), "VIS %d/%d CELLS %d RAYS %d US  ENEMIES %d US",
+                          (int)vis.getVisibleCells().size(), vis.getCellsVisited(),
+                          vis.getRayCount(), (int)(vis.getLastUpdateMs() * 1000.0f),
+                          (int)(game.enemies.getLastUpdateMs() * 1000.0f));
+            const StreamBuffer::Stats& stream = streamBuffer.getStats();
+            std::snprintf(statsStream, sizeof(statsStream),
+                          "STREAM %ld B %d WRITES  PEAK %ld RING %ld  %d STALLS %d GROWS",
+                          (long)stream.frameBytes, stream.writes, (long)stream.peakFrameBytes,
+                          (long)stream.capacity, stream.stalls, stream.grows);
+            const RenderQueue::Stats& queued = renderQueue.getStats();
+            std::snprintf(statsQueue, sizeof(statsQueue),
+                          "QUEUE %d DRAWS  STATE %d ISSUED %d SKIPPED",
+                          queued.draws, queued.state.issued, queued.state.skipped);
+            statsTimer = 1.0f;
+        }
 
-        // Sky
-        skyRenderer.render(view, projection);
+        // Lighting parameters from sky and torch, plus the hand and unlit
+        // variants, all sent in one uniform buffer upload
+        FrameUniforms::LightingBlock worldLighting;
+        worldLighting.lightDir     = skyRenderer.getSunDirection();
+        worldLighting.fogDensity   = FOG_DENSITY;
+        worldLighting.fogColor     = fogCol;
+        worldLighting.fogGradient  = FOG_GRADIENT;
+        worldLighting.sunColor     = skyRenderer.getSunColor();
+        worldLighting.ambientLevel = skyRenderer.getAmbientLevel();
+        worldLighting.torchPos     = torchLight.getPosition();
+        worldLighting.torchRadius  = torchLight.getRadius();
+        worldLighting.torchColor   = torchLight.getColor();
+
+        frameUniforms.setCamera(FrameUniforms::VIEW_WORLD, view, projection);
+        frameUniforms.setCamera(FrameUniforms::VIEW_HAND, glm::mat4(1.0f),
+                                HandRenderer::getProjection(aspect));
+        frameUniforms.setCamera(FrameUniforms::VIEW_CARRIED, view,
+                                HandRenderer::getProjection(aspect));
+        frameUniforms.setLighting(FrameUniforms::LIGHTING_WORLD, worldLighting);
+        frameUniforms.setLighting(FrameUniforms::LIGHTING_HAND, HandRenderer::getLighting());
+        frameUniforms.setLighting(FrameUniforms::LIGHTING_UNLIT,
+                                  TorchLight::getGlowLighting(worldLighting));
+        frameUniforms.upload();
 
-        // Lighting parameters from sky
-        glm::vec3 sunDir = skyRenderer.getSunDirection();
-        glm::vec3 sunColor = skyRenderer.getSunColor();
-        float ambientLevel = skyRenderer.getAmbientLevel();
+        // Sky
+        skyRenderer.render(view);
 
-        // Torch parameters
-        bool torchOn = torchLight.isEnabled();
-        glm::vec3 torchPos = torchLight.getPosition();
-        glm::vec3 torchCol = torchLight.getColor();
-        float torchRadius = torchLight.getRadius();
+        // The rest of the scene is recorded here and drawn in state order
+        // at the flush below
+        renderQueue.setCamera(game.player.position);
 
         // Maze
-        game.renderer.renderMaze(mainShader, view, projection,
-                                  sunDir, sunColor, ambientLevel, fogCol,
-                                  torchOn, torchPos, torchCol, torchRadius);
+        game.renderer.setTorchLit(torchLight.isEnabled());
+        game.renderer.renderMaze(renderQueue, mazeShaders, mazeGridShaders, mainShaders,
+                                 view, projection);
 
         // Collectibles
-        game.renderer.renderCollectibles(mainShader, view, projection,
-                                          game.collectibles.getItems(),
-                                          sunDir, sunColor, ambientLevel, fogCol,
-                                          torchOn, torchPos, torchCol, torchRadius);
+        game.renderer.renderCollectibles(renderQueue, itemShaders, game.collectibles);
+
+        // Enemies
+        game.renderer.renderEnemies(renderQueue, enemyShaders, game.enemies);
 
         // Exit zone (open area at maze end)
-        game.renderer.renderExitZone(mainShader, view, projection,
-                                     game.exitWorldPos, currentTime,
-                                     sunDir, sunColor, ambientLevel, fogCol,
-                                     torchOn, torchPos, torchCol, torchRadius);
+        game.renderer.renderExitZone(renderQueue, exitShaders, game.exitWorldPos, currentTime);
+
+        // Pickup and delivery sparks
+        game.effects.render(renderQueue, particleShader);
 
         // Torch glow sprite
-        torchLight.renderGlow(mainShader, view, projection);
+        torchLight.renderGlow(renderQueue, mainShaders.get(0), view);
 
-        // Update and render first-person hands
+        // Update and render the viewmodel: both hands in one instanced draw,
+        // the carried stack in another under world lighting
         bool isMoving = keyW || keyA || keyS || keyD;
         bool isJumping = !game.player.isOnGround();
         bool isMovingBack = keyS && !keyW;
         handRenderer.update(frameTime, isMoving, isJumping, isMovingBack);
-        handRenderer.render(mainShader, aspect);
-
-        // Render carried collectibles stacked in the player's hands
-        if (!game.player.carriedItems.empty()) {
-            game.renderer.renderCarriedCollectible(
-                mainShader, view, projection,
-                game.player.position, game.player.getFront(),
-                (int)game.player.carriedItems.size(),
-                sunDir, sunColor, ambientLevel, fogCol,
-                torchOn, torchPos, torchCol, torchRadius);
-        }
+        handRenderer.render(renderQueue, viewmodelShaders,
+                            game.player.position, game.player.getFront(),
+                            (int)game.player.carriedItems.size(),
+                            game.renderer.getMaterialTextures(), torchLight.isEnabled());
+
+        renderQueue.flush(frameUniforms);
 
         // HUD text
         {
-            hud.renderMinimap(hudShader, game.maze, game.player.position, game.player.yaw,
-                              game.exitWorldPos, screenWidth, screenHeight);
+            // One quad; explored cells only change when the player's cell does
+            game.minimap.reveal(game.player.position);
+            game.minimap.render(game.player.position, game.player.yaw,
+                                game.exitWorldPos, screenWidth, screenHeight);
 
             // Boxes delivered counter
             char buf[64];
             std::snprintf(buf, sizeof(buf), "DELIVERED %d",
                           game.boxesDelivered);
-            hud.renderText(hudShader, buf,
+            hud.renderText(HudRenderer::LABEL_DELIVERED, buf,
                            20, (float)screenHeight - 40, 16, 24,
                            0.3f, 1.0f, 0.5f,
                            screenWidth, screenHeight);
@@ -888,7 +1003,7 @@ int main() {
             int stackSize = (int)game.player.carriedItems.size();
             if (stackSize > 0) {
                 std::snprintf(buf, sizeof(buf), "CARRY %d", stackSize);
-                hud.renderText(hudShader, buf,
+                hud.renderText(HudRenderer::LABEL_CARRY, buf,
                                20, (float)screenHeight - 70, 12, 18,
                                1.0f, 0.84f, 0.0f,
                                screenWidth, screenHeight);
@@ -899,7 +1014,7 @@ int main() {
             int mins = totalSec / 60;
             int secs = totalSec % 60;
             std::snprintf(buf, sizeof(buf), "%02d:%02d", mins, secs);
-            hud.renderText(hudShader, buf,
+            hud.renderText(HudRenderer::LABEL_TIMER, buf,
                            20, (float)screenHeight - 100, 16, 24,
                            1.0f, 1.0f, 1.0f,
                            screenWidth, screenHeight);
@@ -907,17 +1022,33 @@ int main() {
             // Difficulty indicator
             auto cfg = getDifficultyConfig(currentDifficulty);
             std::snprintf(buf, sizeof(buf), "%s", cfg.name);
-            hud.renderText(hudShader, buf,
+            hud.renderText(HudRenderer::LABEL_DIFFICULTY, buf,
                            20, (float)screenHeight - 130, 12, 18,
                            0.6f, 0.6f, 0.8f,
                            screenWidth, screenHeight);
 
+            // F3 performance stats
+            if (showStats) {
+                hud.renderText(HudRenderer::LABEL_STATS_VIS, statsVis,
+                               20, (float)screenHeight - 160, 8, 12,
+                               0.7f, 0.7f, 0.7f,
+                               screenWidth, screenHeight);
+                hud.renderText(HudRenderer::LABEL_STATS_STREAM, statsStream,
+                               20, (float)screenHeight - 180, 8, 12,
+                               0.7f, 0.7f, 0.7f,
+                               screenWidth, screenHeight);
+                hud.renderText(HudRenderer::LABEL_STATS_QUEUE, statsQueue,
+                               20, (float)screenHeight - 200, 8, 12,
+                               0.7f, 0.7f, 0.7f,
+                               screenWidth, screenHeight);
+            }
+
             // Win screen
             if (game.won) {
                 float winElapsed = currentTime - game.winScreenStartTime;
 
                 // Timer display
-                hud.renderText(hudShader, std::string(buf),
+                hud.renderText(HudRenderer::LABEL_WIN_TIME, buf,
                                (float)screenWidth / 2 - 60,
                                (float)screenHeight / 2,
                                24, 36,
@@ -925,13 +1056,12 @@ int main() {
                                screenWidth, screenHeight);
 
                 // Animated stars
-                hud.renderWinStars(hudShader, game.starResult.stars, winElapsed,
+                hud.renderWinStars(game.starResult.stars, winElapsed,
                                    game.winParticles, screenWidth, screenHeight);
 
                 // Perfect run indicator (golden star badge)
                 if (game.starResult.perfectRun) {
-                    hud.renderSmallStars(hudShader,
-                                         (float)screenWidth / 2,
+                    hud.renderSmallStars((float)screenWidth / 2,
                                          (float)screenHeight / 2 + 40,
                                          1, 1,
                                          screenWidth, screenHeight);
@@ -940,7 +1070,7 @@ int main() {
                 // Score (based on boxes delivered)
                 int score = game.boxesDelivered * 100;
                 std::snprintf(buf, sizeof(buf), "BOXES %d", game.boxesDelivered);
-                hud.renderText(hudShader, buf,
+                hud.renderText(HudRenderer::LABEL_WIN_BOXES, buf,
                                (float)screenWidth / 2 - 80,
                                (float)screenHeight / 2 - 80,
                                16, 24,
@@ -948,7 +1078,7 @@ int main() {
                                screenWidth, screenHeight);
 
                 std::snprintf(buf, sizeof(buf), "SCORE %05d", score);
-                hud.renderText(hudShader, buf,
+                hud.renderText(HudRenderer::LABEL_WIN_SCORE, buf,
                                (float)screenWidth / 2 - 80,
                                (float)screenHeight / 2 - 120,
                                20, 30,
@@ -961,17 +1091,28 @@ int main() {
                     requestRestart = false;
                 }
             }
+
+            // Text and stars in one draw, star bursts on top
+            hud.flush(hudShader);
+            game.winParticles.render(renderQueue, particleShader);
+            renderQueue.flush(frameUniforms);
         }
 
+        streamBuffer.endFrame();
+        renderQueue.endFrame();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
     hud.cleanup();
+    game.minimap.cleanup();
+    game.winParticles.cleanup();
+    game.effects.cleanup();
     titleScreen.cleanup();
     handRenderer.cleanup();
     skyRenderer.cleanup();
     torchLight.cleanup();
+    streamBuffer.cleanup();
     glfwTerminate();
     return 0;
 }